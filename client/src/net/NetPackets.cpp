@@ -59,10 +59,6 @@ void Screens::handleNetPacket(const char *data, std::size_t n) {
                                              : _expireSecondsDefault;
         if (missed >= _missThreshold && elapsed >= ttl) {
           toErase.push_back(id);
-          // Play explosion sound when an enemy is removed
-          if (type == 2) { // Enemy type
-            playExplosionSound();
-          }
         }
       }
     }
@@ -92,12 +88,6 @@ void Screens::handleNetPacket(const char *data, std::size_t n) {
       return;
     std::uint32_t entityId;
     std::memcpy(&entityId, p, sizeof(entityId));
-
-    // Play explosion sound if the despawned entity was an enemy
-    if (_entityById.count(entityId) && _entityById[entityId].type == 2) {
-      playExplosionSound();
-    }
-
     _entityById.erase(entityId);
     _missedById.erase(entityId);
     _lastSeenAt.erase(entityId);
@@ -166,6 +156,25 @@ void Screens::handleNetPacket(const char *data, std::size_t n) {
       return;
     auto *su = reinterpret_cast<const rtype::net::ScoreUpdatePayload *>(p);
     _score = su->score;
+  } else if (h->type == rtype::net::MsgType::Kill) {
+    const char *p = data + sizeof(rtype::net::Header);
+    if (n < sizeof(rtype::net::Header) + sizeof(rtype::net::KillHeader))
+      return;
+    auto *kh = reinterpret_cast<const rtype::net::KillHeader *>(p);
+    p += sizeof(rtype::net::KillHeader);
+    std::size_t count = kh->count;
+    if (n < sizeof(rtype::net::Header) + sizeof(rtype::net::KillHeader) +
+                count * sizeof(rtype::net::KillEntry))
+      return;
+    // The explosion sound plays only here: an enemy leaving the screen or
+    // expiring from missed snapshots was not shot down. One per listed
+    // entity; the sound pool is polyphonic
+    for (std::size_t i = 0; i < count; ++i) {
+      rtype::net::KillEntry ke{};
+      std::memcpy(&ke, p + i * sizeof(rtype::net::KillEntry), sizeof(ke));
+      if (ke.id != 0)
+        playExplosionSound();
+    }
   } else if (h->type == rtype::net::MsgType::ReturnToMenu) {
     _serverReturnToMenu = true;
   } else if (h->type == rtype::net::MsgType::LobbyStatus) {
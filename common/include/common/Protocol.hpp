@@ -24,6 +24,7 @@ enum class MsgType : std::uint8_t {
     // New messages
     Disconnect,     // client -> server: explicit disconnect notice
     ReturnToMenu,   // server -> client: ask client to return to menu (e.g., too few players)
+    Kill,           // server -> clients: enemies and bosses destroyed this tick
 
     TcpWelcome = 100,
     StartGame  = 101
@@ -65,7 +66,7 @@ struct InputPacket {
 };
 
 struct PackedEntity {
-    std::uint32_t id;
+    std::uint32_t id; // full generational handle; a recycled slot gets a new id
     EntityType type;
     float x;
     float y;
@@ -112,6 +113,21 @@ struct ScoreUpdatePayload {
 };
 #pragma pack(pop)
 
+// Kills of the last tick, sent once per tick that has any
+// Payload layout: KillHeader + count * KillEntry
+#pragma pack(push, 1)
+struct KillHeader {
+    std::uint8_t count; // number of KillEntry records following
+};
+
+struct KillEntry {
+    std::uint32_t id;     // destroyed enemy (same id as in State)
+    std::uint32_t killer; // player credited, 0 if none
+    std::int32_t points;  // score awarded for it
+    std::uint8_t boss;    // 1 when a boss was defeated
+};
+#pragma pack(pop)
+
 // --- Lobby and match messages ---
 // Server broadcasts the current lobby state to all clients
 #pragma pack(push, 1)
@@ -0,0 +1,30 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+// Timing for the engine benchmarks. Each sample runs fn() `reps` times and
+// the median sample is reported, in microseconds per call, so a stray page
+// fault or preemption does not move the figure. Build them in Release.
+namespace rt::bench {
+
+template <typename F>
+double medianUs(F&& fn, int reps = 50, int samples = 15) {
+    using clock = std::chrono::steady_clock;
+    fn(); // warm caches and let pools reach their size
+    std::vector<double> us;
+    us.reserve(static_cast<std::size_t>(samples));
+    for (int s = 0; s < samples; ++s) {
+        const auto start = clock::now();
+        for (int i = 0; i < reps; ++i) fn();
+        const std::chrono::duration<double, std::micro> d = clock::now() - start;
+        us.push_back(d.count() / reps);
+    }
+    std::nth_element(us.begin(), us.begin() + samples / 2, us.end());
+    return us[static_cast<std::size_t>(samples / 2)];
+}
+
+// Written at the end of a benchmark so the timed work has an observable result
+inline volatile double sink = 0.0;
+
+}
@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "Bench.hpp"
+#include "rt/ecs/Registry.hpp"
+#include "rt/game/Components.hpp"
+#include "rt/game/Systems.hpp"
+#include "rt/simd/Kernels.hpp"
+
+// Movement integration over n moving entities (plus a fifth as many static
+// ones), four ways:
+//   view      view<Transform, const Velocity>, pools in unrelated orders
+//   scalar    owning group, axpyScalar over the index-aligned pools
+//   simd      owning group, axpy (the vector path this build picked)
+//   system    MovementSystem::update, i.e. simd plus change stamps
+using namespace rt::game;
+using rt::ecs::Entity;
+using rt::ecs::Registry;
+
+namespace {
+
+constexpr float kDt = 1.f / 60.f;
+
+// Velocity is added in a shuffled order, as spawns and despawns leave it
+void populate(Registry& r, std::size_t n) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> pos(0.f, 960.f), vel(-200.f, 200.f);
+    std::vector<Entity> moving;
+    for (std::size_t i = 0; i < n + n / 5; ++i) {
+        const Entity e = r.create();
+        r.emplace<Transform>(e, Transform{pos(rng), pos(rng)});
+        if (i % 6 != 5) moving.push_back(e);
+    }
+    moving.resize(std::min(moving.size(), n));
+    std::shuffle(moving.begin(), moving.end(), rng);
+    for (Entity e : moving) r.emplace<Velocity>(e, Velocity{vel(rng), vel(rng)});
+}
+
+double checksum(Registry& r) {
+    double sum = 0.0;
+    for (const auto& t : r.storage<Transform>().components()) sum += t.x + t.y;
+    return sum;
+}
+
+}
+
+int main() {
+    std::printf("movement, %s kernel, us per tick\n", rt::simd::kernelName());
+    std::printf("%8s %10s %10s %10s %10s\n", "moving", "view", "scalar", "simd", "system");
+    for (std::size_t n : {1000u, 10000u, 50000u}) {
+        Registry viewed;
+        populate(viewed, n);
+        const double view = rt::bench::medianUs([&] {
+            viewed.view<Transform, const Velocity>().each([](Transform& t, const Velocity& v) {
+                t.x += v.vx * kDt;
+                t.y += v.vy * kDt;
+            });
+        });
+
+        Registry grouped;
+        populate(grouped, n);
+        auto moving = grouped.group<Transform, Velocity>();
+        auto* pos = reinterpret_cast<float*>(moving.raw<Transform>());
+        const auto* vel = reinterpret_cast<const float*>(moving.raw<Velocity>());
+        const double scalar = rt::bench::medianUs([&] { rt::simd::axpyScalar(pos, vel, kDt, 2 * moving.size()); });
+        const double simd = rt::bench::medianUs([&] { rt::simd::axpy(pos, vel, kDt, 2 * moving.size()); });
+
+        MovementSystem system;
+        const double full = rt::bench::medianUs([&] { system.update(grouped, kDt); });
+
+        std::printf("%8zu %10.2f %10.2f %10.2f %10.2f\n", n, view, scalar, simd, full);
+        rt::bench::sink = rt::bench::sink + checksum(viewed) + checksum(grouped);
+    }
+    return 0;
+}
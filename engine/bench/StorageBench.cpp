@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include "Bench.hpp"
+#include "rt/ecs/Storage.hpp"
+
+// ComponentStorage (sparse set) against the std::unordered_map<Entity, C>
+// pool it replaced, on n two-float components inserted in shuffled entity
+// order:
+//   insert   fill an empty pool
+//   iterate  sum every component
+//   get      look up every entity, in another shuffled order
+//   remove   erase every other entity, then put them back
+using rt::ecs::Entity;
+
+namespace {
+
+struct Pos {
+    float x = 0.f, y = 0.f;
+};
+
+// The pool as it was before the sparse set
+struct MapStorage {
+    Pos* get(Entity e) {
+        auto it = data.find(e);
+        return it == data.end() ? nullptr : &it->second;
+    }
+    Pos& emplace(Entity e, const Pos& c) { return data[e] = c; }
+    void remove(Entity e) { data.erase(e); }
+    std::unordered_map<Entity, Pos> data;
+};
+
+float sum(const MapStorage& s) {
+    float acc = 0.f;
+    for (const auto& [e, p] : s.data) acc += p.x + p.y;
+    return acc;
+}
+
+float sum(const rt::ecs::ComponentStorage<Pos>& s) {
+    float acc = 0.f;
+    for (const auto& p : s.components()) acc += p.x + p.y;
+    return acc;
+}
+
+struct Row {
+    double insert, iterate, get, remove;
+};
+
+template <typename Pool>
+Row run(const std::vector<Entity>& order, const std::vector<Entity>& probe) {
+    Row row{};
+    row.insert = rt::bench::medianUs([&] {
+        Pool pool;
+        for (Entity e : order) pool.emplace(e, Pos{1.f, 2.f});
+        rt::bench::sink = rt::bench::sink + static_cast<double>(pool.get(order.front())->x);
+    }, 5, 9);
+
+    Pool pool;
+    for (Entity e : order) pool.emplace(e, Pos{1.f, 2.f});
+    row.iterate = rt::bench::medianUs([&] { rt::bench::sink = rt::bench::sink + sum(pool); });
+    row.get = rt::bench::medianUs([&] {
+        float acc = 0.f;
+        for (Entity e : probe) acc += pool.get(e)->x;
+        rt::bench::sink = rt::bench::sink + acc;
+    }, 10);
+    row.remove = rt::bench::medianUs([&] {
+        for (std::size_t i = 0; i < probe.size(); i += 2) pool.remove(probe[i]);
+        for (std::size_t i = 0; i < probe.size(); i += 2) pool.emplace(probe[i], Pos{3.f, 4.f});
+    }, 5, 9);
+    return row;
+}
+
+}
+
+int main() {
+    std::printf("component pool, us per pass over all n entities\n");
+    std::printf("%8s %-7s %10s %10s %10s %10s\n", "n", "pool", "insert", "iterate", "get", "remove");
+    std::mt19937 rng(7);
+    for (std::size_t n : {1000u, 10000u, 100000u}) {
+        std::vector<Entity> order(n);
+        for (std::size_t i = 0; i < n; ++i) order[i] = rt::ecs::makeEntity(static_cast<std::uint32_t>(i + 1), 0);
+        std::shuffle(order.begin(), order.end(), rng);
+        std::vector<Entity> probe = order;
+        std::shuffle(probe.begin(), probe.end(), rng);
+
+        const Row map = run<MapStorage>(order, probe);
+        const Row sparse = run<rt::ecs::ComponentStorage<Pos>>(order, probe);
+        for (const auto& [name, r] : {std::pair{"map", map}, std::pair{"sparse", sparse}})
+            std::printf("%8zu %-7s %10.2f %10.2f %10.2f %10.2f\n", n, name, r.insert, r.iterate, r.get, r.remove);
+    }
+    return 0;
+}
@@ -1,3 +1,243 @@
 #include "rt/ecs/Registry.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include "rt/jobs/JobSystem.hpp"
 using namespace rt::ecs;
-// No-op implementation file to keep library structure
+
+std::size_t rt::ecs::detail::nextComponentId() {
+    static std::atomic<std::size_t> next{0};
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::size_t rt::ecs::detail::nextResourceId() {
+    static std::atomic<std::size_t> next{0};
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+std::uint64_t nanos(Clock::time_point from, Clock::time_point to) {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count());
+}
+
+// Adds what the calling thread did since `before` to `into`
+void credit(detail::WorkCounters& into, const detail::WorkCounters& before) {
+    into.processed += detail::work.processed - before.processed;
+    into.created += detail::work.created - before.created;
+    into.destroyed += detail::work.destroyed - before.destroyed;
+}
+}
+
+void Registry::update(float dt) {
+    ++tick_;
+    flush();
+    // Scratch kept across ticks, so a steady tick does not allocate here
+    auto& run = due_;
+    run.resize(systems_.size());
+    for (std::size_t i = 0; i < systems_.size(); ++i) run[i] = due(i, dt);
+    ++frame_;
+    // Clock reads are chained: a system's time runs from the end of the
+    // previous one to the end of its flush, one read per system
+    if (!jobs_ || jobs_->workerCount() == 0) {
+        auto last = Clock::now();
+        for (std::size_t i = 0; i < systems_.size(); ++i) {
+            if (!run[i]) continue;
+            const auto before = detail::work;
+            runSystem(i);
+            buffers_[i]->flush();
+            const auto now = Clock::now();
+            record(i, nanos(last, now), before);
+            last = now;
+        }
+        return;
+    }
+    if (waves_.empty()) plan();
+    auto& tasks = tasks_;
+    for (const auto& wave : waves_) {
+        tasks.clear();
+        for (auto i : wave) {
+            if (!run[i]) continue;
+            tasks.emplace_back([this, i] {
+                auto& p = runs_[i].profile;
+                const auto before = detail::work;
+                const auto start = Clock::now();
+                runSystem(i);
+                p.pendingNs = nanos(start, Clock::now());
+                credit(p.work, before);
+            });
+        }
+        if (tasks.size() == 1) tasks.front()();
+        else if (!tasks.empty()) jobs_->run(tasks);
+        auto last = Clock::now();
+        for (auto i : wave) {
+            if (!run[i]) continue;
+            const auto before = detail::work;
+            buffers_[i]->flush();
+            const auto now = Clock::now();
+            record(i, runs_[i].profile.pendingNs + nanos(last, now), before);
+            last = now;
+        }
+    }
+}
+
+void Registry::runSystem(std::size_t i) {
+    auto& run = runs_[i];
+    const auto slices = run.schedule.slices;
+    Bind bind(buffers_[i].get(), Slice{static_cast<std::uint32_t>(run.runs++ % slices), slices});
+    const float dt = run.elapsed;
+    run.elapsed = 0.f;
+    systems_[i]->update(*this, dt);
+}
+
+void Registry::record(std::size_t i, std::uint64_t ns, const detail::WorkCounters& before) {
+    auto& p = runs_[i].profile;
+    credit(p.work, before);
+    p.samples[p.runs % p.samples.size()] =
+        static_cast<std::uint32_t>(std::min<std::uint64_t>(ns, ~std::uint32_t{0}));
+    p.totalNs += ns;
+    ++p.runs;
+}
+
+// Percentiles are only computed here, on a copy of the window
+std::vector<SystemStats> Registry::systemStats() const {
+    std::vector<SystemStats> out;
+    out.reserve(systems_.size());
+    std::array<std::uint32_t, SystemStats::kWindow> window;
+    for (std::size_t i = 0; i < systems_.size(); ++i) {
+        const auto& p = runs_[i].profile;
+        SystemStats s;
+        s.name = systems_[i]->name();
+        s.runs = p.runs;
+        s.totalUs = static_cast<double>(p.totalNs) / 1000.0;
+        s.processed = p.work.processed;
+        s.created = p.work.created;
+        s.destroyed = p.work.destroyed;
+        const auto n = static_cast<std::size_t>(std::min<std::uint64_t>(p.runs, window.size()));
+        if (n > 0) {
+            std::copy_n(p.samples.begin(), n, window.begin());
+            std::sort(window.begin(), window.begin() + n);
+            auto us = [&](double q) {
+                return static_cast<double>(window[static_cast<std::size_t>(q * static_cast<double>(n - 1) + 0.5)]) / 1000.0;
+            };
+            s.p50Us = us(0.50);
+            s.p99Us = us(0.99);
+            s.maxUs = us(1.0);
+        }
+        out.push_back(s);
+    }
+    return out;
+}
+
+void Registry::resetSystemStats() {
+    for (auto& run : runs_) run.profile = Profile{};
+}
+
+// Each system lands one wave after the last earlier system it conflicts with.
+// Declared pools and ctx() entries are created here, so neither table grows
+// while a wave runs.
+void Registry::plan() {
+    std::vector<Access> access;
+    std::vector<std::size_t> level(systems_.size(), 0);
+    access.reserve(systems_.size());
+    waves_.clear();
+    for (std::size_t i = 0; i < systems_.size(); ++i) {
+        access.push_back(systems_[i]->access());
+        for (auto ensure : access[i].pools) ensure(*this);
+        for (std::size_t j = 0; j < i; ++j)
+            if (access[i].conflicts(access[j])) level[i] = std::max(level[i], level[j] + 1);
+        if (level[i] >= waves_.size()) waves_.resize(level[i] + 1);
+        waves_[level[i]].push_back(i);
+    }
+}
+
+void Registry::snapshot(Snapshot& out) const {
+    out.slots_ = slots_;
+    out.alivePos_ = alivePos_;
+    out.free_ = free_;
+    out.signatures_ = signatures_;
+    out.alive_ = alive_;
+    out.pools_.resize(pools_.size());
+    for (std::size_t id = 0; id < pools_.size(); ++id) {
+        if (pools_[id]) {
+            pools_[id]->save(out.pools_[id]);
+        } else {
+            out.pools_[id].size = 0;
+            out.pools_[id].make = nullptr;
+        }
+    }
+    out.groups_.clear();
+    for (const auto& g : groups_) out.groups_.emplace_back(g->owned, g->len);
+    out.tick_ = tick_;
+}
+
+// Pools the snapshot lacks are emptied, and group lengths are copied only
+// when both sides have the same groups; otherwise every group is re-sorted.
+void Registry::restore(const Snapshot& s) {
+    slots_ = s.slots_;
+    alivePos_ = s.alivePos_;
+    free_ = s.free_;
+    signatures_ = s.signatures_;
+    alive_ = s.alive_;
+    static const PoolImage kEmpty{};
+    if (pools_.size() < s.pools_.size()) pools_.resize(s.pools_.size());
+    for (std::size_t id = 0; id < pools_.size(); ++id) {
+        const PoolImage* in = id < s.pools_.size() && s.pools_[id].make ? &s.pools_[id] : nullptr;
+        if (!pools_[id]) {
+            if (!in) continue;
+            pools_[id] = in->make(&tick_);
+        }
+        pools_[id]->load(in ? *in : kEmpty);
+    }
+    const bool sameGroups = groups_.size() == s.groups_.size()
+        && std::equal(groups_.begin(), groups_.end(), s.groups_.begin(),
+                      [](const auto& g, const auto& saved) { return g->owned == saved.first; });
+    if (sameGroups) {
+        for (std::size_t i = 0; i < groups_.size(); ++i) groups_[i]->len = s.groups_[i].second;
+    } else {
+        for (auto& g : groups_) g->len = 0;
+        for (auto e : alive_) enterGroups(e);
+    }
+    tick_ = std::max(tick_, s.tick_);
+}
+
+// Groups are ordered outer first, so the members of a nested group end up at
+// the front of its enclosing group. Every group is re-sorted from scratch.
+Registry::GroupData& Registry::addGroup(Signature mask, std::vector<IStorage*> pools) {
+    for (const auto& g : groups_) {
+        const Signature shared = g->owned & mask;
+        if (shared && shared != g->owned && shared != mask)
+            throw std::logic_error("rt::ecs::Registry: groups sharing a pool must be nested");
+    }
+    auto at = std::find_if(groups_.begin(), groups_.end(), [mask](const auto& g) {
+        return std::popcount(g->owned) > std::popcount(mask);
+    });
+    auto& out = **groups_.insert(at, std::make_unique<GroupData>(GroupData{mask, 0, std::move(pools)}));
+    owned_ |= mask;
+    for (auto& g : groups_) g->len = 0;
+    for (auto e : alive_) enterGroups(e);
+    return out;
+}
+
+// Swaps `e` to the end of each group it now completes, outermost first
+void Registry::enterGroups(Entity e) {
+    const Signature sig = signatures_[entityIndex(e)];
+    for (auto& g : groups_) {
+        if ((sig & g->owned) != g->owned || g->pools.front()->index(e) < g->len) continue;
+        for (auto* p : g->pools) p->swapAt(p->index(e), static_cast<std::uint32_t>(g->len));
+        ++g->len;
+    }
+}
+
+// Swaps `e` to the end of each group that owns one of `lost`, innermost first,
+// and shrinks it; the pool removal that follows then never touches members
+void Registry::leaveGroups(Entity e, Signature lost) {
+    for (auto it = groups_.rbegin(); it != groups_.rend(); ++it) {
+        auto& g = **it;
+        if (!(g.owned & lost) || g.pools.front()->index(e) >= g.len) continue;
+        const auto last = static_cast<std::uint32_t>(--g.len);
+        for (auto* p : g.pools) p->swapAt(p->index(e), last);
+    }
+}
@@ -5,14 +5,26 @@
 #include <vector>
 #include <iostream>
 #include "rt/game/Systems.hpp"
+#include "rt/jobs/JobSystem.hpp"
+#include "rt/simd/Kernels.hpp"
 using namespace rt::game;
 
+namespace {
+const rt::ecs::Prefab<Transform, Velocity, NetType, ColorRGBA, BulletTag, BulletOwner, Size> kPlayerBullet{
+    {}, {}, {static_cast<rtype::net::EntityType>(3)}, {0xFFFF55FFu}, {BulletFaction::Player}, {}, {6.f, 3.f}};
+const rt::ecs::Prefab<Transform, Velocity, NetType, ColorRGBA, BulletTag, Size> kEnemyBullet{
+    {}, {}, {static_cast<rtype::net::EntityType>(3)}, {0xFFAA00FFu}, {BulletFaction::Enemy}, {6.f, 3.f}};
+
+// Formation member; position and slot are set per enemy
+using EnemyPrefab = rt::ecs::Prefab<Transform, FormationFollower, Velocity, NetType, ColorRGBA, EnemyTag, Size>;
+EnemyPrefab enemyPrefab(rt::ecs::Entity origin, float vx, std::uint32_t rgba) {
+    return EnemyPrefab{{}, {origin}, {vx, 0.f}, {static_cast<rtype::net::EntityType>(2)}, {rgba}, {}, {27.f, 18.f}};
+}
+}
+
 void InputSystem::update(rt::ecs::Registry& r, float dt) {
     (void)dt;
-    auto& inputs = r.storage<PlayerInput>().data();
-    for (auto& [e, inp] : inputs) {
-        auto* t = r.get<Transform>(e);
-        if (!t) continue;
+    r.view<const PlayerInput, Transform>().each([dt](const PlayerInput& inp, Transform& t) {
         float vx = 0.f, vy = 0.f;
         constexpr std::uint8_t kUp = 1 << 0;
         constexpr std::uint8_t kDown = 1 << 1;
@@ -23,115 +35,164 @@ void InputSystem::update(rt::ecs::Registry& r, float dt) {
         if (inp.bits & kUp)    vy -= inp.speed;
         if (inp.bits & kDown)  vy += inp.speed;
         // Directly integrate on transform (simple for now)
-        t->x += vx * dt;
-        t->y += vy * dt;
-    }
+        t.x += vx * dt;
+        t.y += vy * dt;
+    });
+}
+
+rt::ecs::Access InputSystem::access() const {
+    return rt::ecs::Access{}.read<PlayerInput>().write<Transform>();
 }
 
 void MovementSystem::update(rt::ecs::Registry& r, float dt) {
-    auto& vels = r.storage<Velocity>().data();
-    for (auto& [e, v] : vels) {
-        auto* t = r.get<Transform>(e);
-        if (!t) continue;
-        t->x += v.vx * dt;
-        t->y += v.vy * dt;
-    }
+    // Transform and Velocity are both two packed floats: the group keeps the
+    // pools index-aligned, so integration is one flat pos[i] += vel[i] * dt stream
+    static_assert(sizeof(Transform) == 2 * sizeof(float) && sizeof(Velocity) == 2 * sizeof(float));
+    auto moving = r.group<Transform, Velocity>();
+    auto* pos = reinterpret_cast<float*>(moving.raw<Transform>());
+    const auto* vel = reinterpret_cast<const float*>(moving.raw<Velocity>());
+    auto integrate = [&](std::size_t begin, std::size_t end) {
+        rt::simd::axpy(pos + 2 * begin, vel + 2 * begin, dt, 2 * (end - begin));
+        moving.touch<Transform>(begin, end);
+    };
+    if (auto* jobs = r.jobs()) jobs->parallelFor(moving.size(), 0, integrate);
+    else integrate(0, moving.size());
+    rt::ecs::Registry::countProcessed(moving.size());
+}
+
+rt::ecs::Access MovementSystem::access() const {
+    // group() sorts both pools when it creates the group
+    return rt::ecs::Access{}.write<Velocity, Transform>();
 }
 
 void ShootingSystem::update(rt::ecs::Registry& r, float dt) {
     // For every player with PlayerInput and Shooter, spawn bullets while holding shoot
-    auto& inputs = r.storage<PlayerInput>().data();
     constexpr std::uint8_t kShoot = 1 << 4;
-    for (auto& [e, inp] : inputs) {
-        auto* shooter = r.get<Shooter>(e);
-        auto* t = r.get<Transform>(e);
-        if (!shooter || !t) continue;
-        shooter->cooldown -= dt;
+    auto& cmd = r.commands();
+    r.view<const PlayerInput, Shooter, const Transform>().each(
+        [&](rt::ecs::Entity e, const PlayerInput& inp, Shooter& shooter, const Transform& t) {
+        shooter.cooldown -= dt;
         bool wantShoot = (inp.bits & kShoot) != 0;
-        while (wantShoot && shooter->cooldown <= 0.f) {
-            shooter->cooldown += shooter->interval;
-            // Spawn a bullet entity slightly ahead of the player ship
-            auto b = r.create();
-            float bx = t->x + 20.f; // assuming player ship width ~20
-            float by = t->y + 5.f;  // center roughly
-            r.emplace<Transform>(b, {bx, by});
-            r.emplace<Velocity>(b, {shooter->bulletSpeed, 0.f});
-            r.emplace<NetType>(b, {static_cast<rtype::net::EntityType>(3)});
-            r.emplace<ColorRGBA>(b, {0xFFFF55FFu});
-            r.emplace<BulletTag>(b, {BulletFaction::Player});
-            r.emplace<BulletOwner>(b, {e});
-            r.emplace<Size>(b, {6.f, 3.f});
+        std::size_t shots = 0;
+        while (wantShoot && shooter.cooldown <= 0.f) {
+            shooter.cooldown += shooter.interval;
+            ++shots;
         }
-    }
+        // Spawn the bullets slightly ahead of the player ship
+        cmd.spawn(kPlayerBullet, shots, [&](std::size_t, rt::ecs::Entity, Transform& bt, Velocity& v,
+                                            NetType&, ColorRGBA&, BulletTag&, BulletOwner& owner, Size&) {
+            bt = {t.x + 20.f, t.y + 5.f}; // assuming player ship width ~20, center roughly
+            v = {shooter.bulletSpeed, 0.f};
+            owner = {e};
+        });
+    });
+}
+
+rt::ecs::Access ShootingSystem::access() const {
+    return rt::ecs::Access{}
+        .read<PlayerInput, Transform>()
+        .write<Shooter, Transform, Velocity, NetType, ColorRGBA, BulletTag, Size, BulletOwner>()
+        .structural();
 }
 
 void ChargeShootingSystem::update(rt::ecs::Registry& r, float dt) {
     (void)dt;
     constexpr std::uint8_t kCharge = 1 << 5; // must match Protocol InputCharge
-    auto& inputs = r.storage<PlayerInput>().data();
-    for (auto& [e, inp] : inputs) {
-        auto* t = r.get<Transform>(e);
-        if (!t) continue;
-        auto* cg = r.get<ChargeGun>(e);
-        if (!cg) continue; // optional feature per player
+    // ChargeGun is an optional feature per player
+    auto& cmd = r.commands();
+    r.view<const PlayerInput, const Transform, ChargeGun>().each(
+        [&](rt::ecs::Entity e, const PlayerInput& inp, const Transform& t, ChargeGun& cg) {
         bool holding = (inp.bits & kCharge) != 0;
         if (holding) {
-            cg->charge = std::min(cg->maxCharge, cg->charge + dt);
+            cg.charge = std::min(cg.maxCharge, cg.charge + dt);
         } else {
-            if (cg->charge > 0.05f) {
+            if (cg.charge > 0.05f) {
                 // Fire beam once, thickness based on charge
-                float thickness = 8.f + (cg->charge / cg->maxCharge) * 44.f; // 8..52
-                auto b = r.create();
-                float bx = t->x + 10.f; // from player
-                float by = t->y + 6.f;  // centered on player
-                r.emplace<Transform>(b, {bx, by - thickness * 0.5f});
+                float thickness = 8.f + (cg.charge / cg.maxCharge) * 44.f; // 8..52
+                auto b = cmd.create();
+                float bx = t.x + 10.f; // from player
+                float by = t.y + 6.f;  // centered on player
+                cmd.emplace<Transform>(b, {bx, by - thickness * 0.5f});
                 // Beam is instant; represent as a wide, slow-moving rectangle that lives one tick
-                r.emplace<Velocity>(b, {600.f, 0.f});
-                r.emplace<NetType>(b, {static_cast<rtype::net::EntityType>(3)});
-                r.emplace<ColorRGBA>(b, {0x77CCFFFFu});
-                r.emplace<BulletTag>(b, {BulletFaction::Player});
-                r.emplace<BulletOwner>(b, {e});
-                r.emplace<Size>(b, {700.f, thickness});
-                r.emplace<BeamTag>(b, {});
+                cmd.emplace<Velocity>(b, {600.f, 0.f});
+                cmd.emplace<NetType>(b, {static_cast<rtype::net::EntityType>(3)});
+                cmd.emplace<ColorRGBA>(b, {0x77CCFFFFu});
+                cmd.emplace<BulletTag>(b, {BulletFaction::Player});
+                cmd.emplace<BulletOwner>(b, {e});
+                cmd.emplace<Size>(b, {700.f, thickness});
+                cmd.emplace<BeamTag>(b, {});
                 // Reset charge
-                cg->charge = 0.f;
+                cg.charge = 0.f;
             }
         }
-    }
+    });
+}
+
+rt::ecs::Access ChargeShootingSystem::access() const {
+    return rt::ecs::Access{}
+        .read<PlayerInput, Transform>()
+        .write<ChargeGun, Transform, Velocity, NetType, ColorRGBA, BulletTag, Size, BulletOwner, BeamTag>()
+        .structural();
+}
+
+void SpatialIndexSystem::update(rt::ecs::Registry& r, float dt) {
+    (void)dt;
+    auto& index = r.ctx<rt::spatial::SpatialIndex>();
+    const auto& sizes = r.storage<Size>();
+    index.clear();
+    r.view<const IsPlayer, const Transform>().each([&](rt::ecs::Entity e, const IsPlayer&, const Transform& t) {
+        const auto* sz = sizes.get(e);
+        index.insert(e, {t.x, t.y, t.x + (sz ? sz->w : 0.f), t.y + (sz ? sz->h : 0.f)}, kPlayerLayer);
+    });
+    index.build();
+}
+
+rt::ecs::Access SpatialIndexSystem::access() const {
+    return rt::ecs::Access{}.read<IsPlayer, Transform, Size>().writeCtx<rt::spatial::SpatialIndex>();
 }
 
 // Enemy shooting towards nearest player with variable accuracy
+void EnemyShootingSystem::attach(rt::ecs::Registry& r) {
+    r.onConstruct<EnemyShooter>().connect<&EnemyShootingSystem::arm>(this);
+    for (auto e : r.storage<EnemyShooter>().entities()) arm(r, e);
+}
+
+// Schedules the shot the shooter's cooldown counts down to
+void EnemyShootingSystem::arm(rt::ecs::Registry& r, rt::ecs::Entity e) {
+    auto& es = *r.storage<EnemyShooter>().get(e);
+    shots_.scheduleIn(countdown(es.cooldown, step_), e);
+}
+
 void EnemyShootingSystem::update(rt::ecs::Registry& r, float dt) {
-    // Build a list of players
-    std::vector<rt::ecs::Entity> players;
-    for (auto& [e, _] : r.storage<IsPlayer>().data()) {
-        players.push_back(e);
-    }
-    if (players.empty()) return;
-
-    // Update each enemy with EnemyShooter
-    auto& shooters = r.storage<EnemyShooter>().data();
-    for (auto& [e, es] : shooters) {
-        es.cooldown -= dt;
-        if (es.cooldown > 0.f) continue;
-        auto* t = r.get<Transform>(e);
-        if (!t) continue;
+    const auto& players = r.ctx<rt::spatial::SpatialIndex>();
+    // Cooldowns only run while there is someone to shoot at
+    if (players.size() == 0) return;
+    step_ = dt;
+
+    // Shooters due this tick, in pool order (the order a walk over all of them
+    // would fire in, which the shared rng depends on)
+    auto& shooters = r.storage<EnemyShooter>();
+    due_.clear();
+    shots_.advance([&](rt::ecs::Entity e, std::uint32_t) {
+        if (shooters.contains(e)) due_.push_back(e);
+    });
+    std::sort(due_.begin(), due_.end(), [&](rt::ecs::Entity a, rt::ecs::Entity b) {
+        return shooters.index(a) < shooters.index(b);
+    });
+
+    const auto& transforms = r.storage<Transform>();
+    auto& cmd = r.commands();
+    for (auto e : due_) {
+        const auto* tp = transforms.get(e);
+        if (!tp) continue;
+        auto& es = *shooters.get(e);
+        const auto& t = *tp;
         // Find nearest player
-        rt::ecs::Entity best = players[0];
-        float bestDist2 = std::numeric_limits<float>::infinity();
-        for (auto p : players) {
-            auto* pt = r.get<Transform>(p);
-            if (!pt) continue;
-            float dx = pt->x - t->x;
-            float dy = pt->y - t->y;
-            float d2 = dx*dx + dy*dy;
-            if (d2 < bestDist2) { bestDist2 = d2; best = p; }
-        }
-        auto* pt = r.get<Transform>(best);
-        if (!pt) continue;
+        const auto nearest = players.nearest(t.x, t.y, kPlayerLayer);
+        const auto& pt = players.item(nearest == rt::spatial::SpatialIndex::kNone ? 0 : nearest).box;
         // Compute direction with inaccuracy
-        float dx = pt->x - t->x;
-        float dy = pt->y - t->y;
+        float dx = pt.x - t.x;
+        float dy = pt.y - t.y;
         float len = std::sqrt(dx*dx + dy*dy);
         if (len < 1e-3f) { dx = 1.f; dy = 0.f; len = 1.f; }
         dx /= len; dy /= len;
@@ -144,42 +205,46 @@ void EnemyShootingSystem::update(rt::ecs::Registry& r, float dt) {
         float cs = std::cos(a), sn = std::sin(a);
         float dirx = dx * cs - dy * sn;
         float diry = dx * sn + dy * cs;
-        // Spawn bullet
-        auto b = r.create();
-        float bx = t->x - 10.f; // from enemy front
-        float by = t->y + 6.f;
-        r.emplace<Transform>(b, {bx, by});
-        r.emplace<Velocity>(b, {dirx * es.bulletSpeed, diry * es.bulletSpeed});
-        r.emplace<NetType>(b, {static_cast<rtype::net::EntityType>(3)});
-        r.emplace<ColorRGBA>(b, {0xFFAA00FFu});
-        r.emplace<BulletTag>(b, {BulletFaction::Enemy});
-        r.emplace<Size>(b, {6.f, 3.f});
+        // Spawn bullet from the enemy front
+        cmd.spawn(kEnemyBullet, 1, [&](std::size_t, rt::ecs::Entity, Transform& bt, Velocity& v, auto&...) {
+            bt = {t.x - 10.f, t.y + 6.f};
+            v = {dirx * es.bulletSpeed, diry * es.bulletSpeed};
+        });
         es.cooldown += es.interval;
+        shots_.scheduleIn(countdown(es.cooldown, dt), e);
     }
 }
 
+rt::ecs::Access EnemyShootingSystem::access() const {
+    return rt::ecs::Access{}
+        .read<Transform>()
+        .readCtx<rt::spatial::SpatialIndex>()
+        .write<EnemyShooter, Transform, Velocity, NetType, ColorRGBA, BulletTag, Size>()
+        .writeResource<std::mt19937>()
+        .structural();
+}
+
 void FormationSystem::update(rt::ecs::Registry& r, float dt) {
     (void)dt;
     float time = t_ ? *t_ : 0.f;
-    // Move formation origins and compute follower world positions
-    auto& forms = r.storage<Formation>().data();
-    for (auto& [origin, f] : forms) {
-        // origin moves using its velocity if present
-        if (auto* v = r.get<Velocity>(origin)) {
-            if (auto* t = r.get<Transform>(origin)) {
-                t->x += v->vx * dt;
-                t->y += v->vy * dt;
-            }
-        }
-    }
-    // Update followers
-    auto& followers = r.storage<FormationFollower>().data();
-    for (auto& [e, ff] : followers) {
-        auto* t = r.get<Transform>(e);
-        if (!t) continue;
-        auto* fo = r.get<Formation>(ff.formation);
-        auto* tor = r.get<Transform>(ff.formation);
-        if (!fo || !tor) continue;
+    // Move formation origins (using their velocity if present)
+    r.view<const Formation, const Velocity, Transform>().each(
+        [dt](const Formation&, const Velocity& v, Transform& t) {
+        t.x += v.vx * dt;
+        t.y += v.vy * dt;
+    });
+    // Update followers; their origin and optional components are probed by pool.
+    // A follower only writes its own Transform/Velocity and origins are not
+    // followers, so chunks can run in parallel.
+    const auto& formations = r.storage<Formation>();
+    const auto& transforms = r.storage<Transform>();
+    const auto& sizes = r.storage<Size>();
+    auto& velocities = r.storage<Velocity>();
+    rt::jobs::parallel_for(r.jobs(), r.view<const FormationFollower, Transform>(), 0,
+        [&](rt::ecs::Entity e, const FormationFollower& ff, Transform& t) {
+        auto* fo = formations.get(ff.formation);
+        auto* tor = transforms.get(ff.formation);
+        if (!fo || !tor) return;
         float x = tor->x + ff.localX;
         float y = tor->y + ff.localY;
         switch (fo->type) {
@@ -200,179 +265,172 @@ void FormationSystem::update(rt::ecs::Registry& r, float dt) {
         constexpr float kWorldH = 600.f;        // server world height used across systems
         constexpr float kTopMargin = 56.f;      // reserve top HUD area (~name+lvl bar)
         constexpr float kBottomMargin = 10.f;   // small safety margin at bottom
-        if (auto* sz = r.get<Size>(e)) {
+        if (auto* sz = sizes.get(e)) {
             float maxY = kWorldH - kBottomMargin - std::max(0.f, sz->h);
             y = std::clamp(y, kTopMargin, maxY);
         } else {
             // If size unknown, still keep roughly within screen
             y = std::clamp(y, kTopMargin, kWorldH - kBottomMargin);
         }
-        t->x = x; t->y = y;
+        t.x = x; t.y = y;
         // inherit velocity for serialization
-        if (auto* v = r.get<Velocity>(e)) v->vx = -std::abs(fo->speedX);
-    }
+        if (auto* v = velocities.get(e)) v->vx = -std::abs(fo->speedX);
+    });
+}
+
+rt::ecs::Access FormationSystem::access() const {
+    return rt::ecs::Access{}.read<Formation, FormationFollower, Size>().write<Transform, Velocity>();
 }
 
 void DespawnOffscreenSystem::update(rt::ecs::Registry& r, float dt) {
     (void)dt;
-    std::vector<rt::ecs::Entity> toDestroy;
-    auto& transforms = r.storage<Transform>().data();
-    for (auto& [e, t] : transforms) {
+    auto& cmd = r.commands();
+    // Sweeps only its slice of the Transform pool when added with Schedule::slices
+    const auto slice = r.slice();
+    const auto view = r.view<const Transform>();
+    const auto n = view.sizeHint();
+    view.each(slice.begin(n), slice.end(n), [&](rt::ecs::Entity e, const Transform& t) {
         if (t.x < minX_) {
-            toDestroy.push_back(e);
+            cmd.destroy(e);
         }
-    }
-    for (auto e : toDestroy) r.destroy(e);
+    });
+}
+
+rt::ecs::Access DespawnOffscreenSystem::access() const {
+    return rt::ecs::Access{}.read<Transform>().destroys();
 }
 
 void DespawnOutOfBoundsSystem::update(rt::ecs::Registry& r, float dt) {
     (void)dt;
-    std::vector<rt::ecs::Entity> toDestroy;
-    auto& transforms = r.storage<Transform>().data();
-    for (auto& [e, t] : transforms) {
-        // Only consider bullets for out-of-bounds despawn to avoid killing players
-        if (!r.get<BulletTag>(e)) continue;
-        auto* sz = r.get<Size>(e);
+    auto& cmd = r.commands();
+    const auto& sizes = r.storage<Size>();
+    // Only consider bullets for out-of-bounds despawn to avoid killing players
+    r.view<const BulletTag, const Transform>().each(
+        [&](rt::ecs::Entity e, const BulletTag&, const Transform& t) {
+        auto* sz = sizes.get(e);
         float w = sz ? sz->w : 0.f;
         float h = sz ? sz->h : 0.f;
         if (t.x + w < minX_ || t.x > maxX_ || t.y + h < minY_ || t.y > maxY_) {
-            toDestroy.push_back(e);
+            cmd.destroy(e);
         }
-    }
-    for (auto e : toDestroy) r.destroy(e);
+    });
+}
+
+rt::ecs::Access DespawnOutOfBoundsSystem::access() const {
+    return rt::ecs::Access{}.read<BulletTag, Transform, Size>().destroys();
 }
 
 // --- Spawn formations ---
 rt::ecs::Entity FormationSpawnSystem::spawnSnake(rt::ecs::Registry& r, float y, int count) {
-    auto origin = r.create();
-    r.emplace<Transform>(origin, {980.f, y});
-    r.emplace<Velocity>(origin, {-60.f, 0.f});
-    r.emplace<Formation>(origin, {FormationType::Snake, -60.f, 70.f, 2.5f, 36.f, 0, 0});
+    auto& cmd = r.commands();
+    auto origin = cmd.create();
+    cmd.emplace<Transform>(origin, {980.f, y});
+    cmd.emplace<Velocity>(origin, {-60.f, 0.f});
+    cmd.emplace<Formation>(origin, {FormationType::Snake, -60.f, 70.f, 2.5f, 36.f, 0, 0});
     std::uniform_int_distribution<int> chance(0, 99);
-    for (int i = 0; i < count; ++i) {
-        auto e = r.create();
-        r.emplace<Transform>(e, {980.f + i * 36.f, y});
-        r.emplace<Velocity>(e, {-60.f, 0.f});
-        r.emplace<NetType>(e, {static_cast<rtype::net::EntityType>(2)});
-        r.emplace<ColorRGBA>(e, {0xFF5555FFu});
-        r.emplace<EnemyTag>(e, {});
-        r.emplace<Size>(e, {27.f, 18.f});
-        r.emplace<FormationFollower>(e, {origin, static_cast<std::uint16_t>(i), i * 36.f, 0.f});
+    cmd.spawn(enemyPrefab(origin, -60.f, 0xFF5555FFu), static_cast<std::size_t>(count),
+              [&](std::size_t i, rt::ecs::Entity e, Transform& t, FormationFollower& f, auto&...) {
+        t = {980.f + i * 36.f, y};
+        f = {origin, static_cast<std::uint16_t>(i), i * 36.f, 0.f};
         if (chance(rng_) < (int)shooterPercent_) {
             // attach enemy shooter with interval scaled by difficulty
             float interval = (difficulty_ == 2 ? 0.9f : difficulty_ == 1 ? 1.2f : 1.6f);
-            r.emplace<EnemyShooter>(e, EnemyShooter{0.f, interval, 240.f, 0.65f});
+            cmd.emplace<EnemyShooter>(e, EnemyShooter{0.f, interval, 240.f, 0.65f});
         }
-    }
+    });
     return origin;
 }
 
 rt::ecs::Entity FormationSpawnSystem::spawnLine(rt::ecs::Registry& r, float y, int count) {
-    auto origin = r.create();
-    r.emplace<Transform>(origin, {980.f, y});
-    r.emplace<Velocity>(origin, {-60.f, 0.f});
-    r.emplace<Formation>(origin, {FormationType::Line, -60.f, 0.f, 0.f, 40.f, 0, 0});
+    auto& cmd = r.commands();
+    auto origin = cmd.create();
+    cmd.emplace<Transform>(origin, {980.f, y});
+    cmd.emplace<Velocity>(origin, {-60.f, 0.f});
+    cmd.emplace<Formation>(origin, {FormationType::Line, -60.f, 0.f, 0.f, 40.f, 0, 0});
     std::uniform_int_distribution<int> chance(0, 99);
-    for (int i = 0; i < count; ++i) {
-        auto e = r.create();
-        r.emplace<Transform>(e, {980.f + i * 40.f, y});
-        r.emplace<Velocity>(e, {-60.f, 0.f});
-    r.emplace<NetType>(e, {static_cast<rtype::net::EntityType>(2)});
-        r.emplace<ColorRGBA>(e, {0xE06666FFu});
-        r.emplace<EnemyTag>(e, {});
-        r.emplace<Size>(e, {27.f, 18.f});
-        r.emplace<FormationFollower>(e, {origin, static_cast<std::uint16_t>(i), i * 40.f, 0.f});
+    cmd.spawn(enemyPrefab(origin, -60.f, 0xE06666FFu), static_cast<std::size_t>(count),
+              [&](std::size_t i, rt::ecs::Entity e, Transform& t, FormationFollower& f, auto&...) {
+        t = {980.f + i * 40.f, y};
+        f = {origin, static_cast<std::uint16_t>(i), i * 40.f, 0.f};
         if (chance(rng_) < (int)shooterPercent_) {
             float interval = (difficulty_ == 2 ? 0.9f : difficulty_ == 1 ? 1.2f : 1.6f);
-            r.emplace<EnemyShooter>(e, EnemyShooter{0.f, interval, 240.f, 0.62f});
+            cmd.emplace<EnemyShooter>(e, EnemyShooter{0.f, interval, 240.f, 0.62f});
         }
-    }
+    });
     return origin;
 }
 
 rt::ecs::Entity FormationSpawnSystem::spawnGrid(rt::ecs::Registry& r, float y, int rows, int cols) {
-    auto origin = r.create();
-    r.emplace<Transform>(origin, {980.f, y});
-    r.emplace<Velocity>(origin, {-50.f, 0.f});
-    r.emplace<Formation>(origin, {FormationType::GridRect, -50.f, 0.f, 0.f, 36.f, rows, cols});
+    auto& cmd = r.commands();
+    auto origin = cmd.create();
+    cmd.emplace<Transform>(origin, {980.f, y});
+    cmd.emplace<Velocity>(origin, {-50.f, 0.f});
+    cmd.emplace<Formation>(origin, {FormationType::GridRect, -50.f, 0.f, 0.f, 36.f, rows, cols});
     std::uniform_int_distribution<int> chance(0, 99);
-    for (int rr = 0; rr < rows; ++rr) {
-        for (int cc = 0; cc < cols; ++cc) {
-            int idx = rr * cols + cc;
-            auto e = r.create();
-            r.emplace<Transform>(e, {980.f + cc * 36.f, y + rr * 36.f});
-            r.emplace<Velocity>(e, {-50.f, 0.f});
-            r.emplace<NetType>(e, {static_cast<rtype::net::EntityType>(2)});
-            r.emplace<ColorRGBA>(e, {0xCC4444FFu});
-            r.emplace<EnemyTag>(e, {});
-            r.emplace<Size>(e, {27.f, 18.f});
-            r.emplace<FormationFollower>(e, {origin, static_cast<std::uint16_t>(idx), cc * 36.f, rr * 36.f});
-            if (chance(rng_) < (int)shooterPercent_) {
-                float interval = (difficulty_ == 2 ? 1.0f : difficulty_ == 1 ? 1.3f : 1.7f);
-                r.emplace<EnemyShooter>(e, EnemyShooter{0.f, interval, 220.f, 0.60f});
-            }
+    // Row-major: member idx sits at row idx / cols, column idx % cols
+    cmd.spawn(enemyPrefab(origin, -50.f, 0xCC4444FFu), static_cast<std::size_t>(std::max(0, rows * cols)),
+              [&](std::size_t idx, rt::ecs::Entity e, Transform& t, FormationFollower& f, auto&...) {
+        const int rr = static_cast<int>(idx) / cols;
+        const int cc = static_cast<int>(idx) % cols;
+        t = {980.f + cc * 36.f, y + rr * 36.f};
+        f = {origin, static_cast<std::uint16_t>(idx), cc * 36.f, rr * 36.f};
+        if (chance(rng_) < (int)shooterPercent_) {
+            float interval = (difficulty_ == 2 ? 1.0f : difficulty_ == 1 ? 1.3f : 1.7f);
+            cmd.emplace<EnemyShooter>(e, EnemyShooter{0.f, interval, 220.f, 0.60f});
         }
-    }
+    });
     return origin;
 }
 
 rt::ecs::Entity FormationSpawnSystem::spawnTriangle(rt::ecs::Registry& r, float y, int rows) {
-    auto origin = r.create();
-    r.emplace<Transform>(origin, {980.f, y});
-    r.emplace<Velocity>(origin, {-55.f, 0.f});
-    r.emplace<Formation>(origin, {FormationType::Triangle, -55.f, 0.f, 0.f, 36.f, rows, 0});
-    int idx = 0;
-    // Left-pointing triangle: apex on the left, expanding columns to the right
+    auto& cmd = r.commands();
+    auto origin = cmd.create();
+    cmd.emplace<Transform>(origin, {980.f, y});
+    cmd.emplace<Velocity>(origin, {-55.f, 0.f});
+    cmd.emplace<Formation>(origin, {FormationType::Triangle, -55.f, 0.f, 0.f, 36.f, rows, 0});
+    // Left-pointing triangle: apex on the left, expanding columns to the right;
+    // column cc holds cc + 1 enemies, filled top to bottom
     std::uniform_int_distribution<int> chance(0, 99);
-    for (int cc = 0; cc < rows; ++cc) {
+    int cc = 0, rr = 0;
+    cmd.spawn(enemyPrefab(origin, -55.f, 0xDD7777FFu), static_cast<std::size_t>(std::max(0, rows * (rows + 1) / 2)),
+              [&](std::size_t idx, rt::ecs::Entity e, Transform& t, FormationFollower& f, auto&...) {
         int count = cc + 1; // number of enemies in this column
         float startY = -0.5f * (count - 1) * 36.f; // center vertically per column
-        for (int rr = 0; rr < count; ++rr) {
-            auto e = r.create();
-            float localX = cc * 36.f;
-            float localY = startY + rr * 36.f;
-            r.emplace<Transform>(e, {980.f + localX, y + localY});
-            r.emplace<Velocity>(e, {-55.f, 0.f});
-            r.emplace<NetType>(e, {static_cast<rtype::net::EntityType>(2)});
-            r.emplace<ColorRGBA>(e, {0xDD7777FFu});
-            r.emplace<EnemyTag>(e, {});
-            r.emplace<Size>(e, {27.f, 18.f});
-            r.emplace<FormationFollower>(e, {origin, static_cast<std::uint16_t>(idx++), localX, localY});
-            if (chance(rng_) < (int)shooterPercent_) {
-                float interval = (difficulty_ == 2 ? 1.0f : difficulty_ == 1 ? 1.3f : 1.7f);
-                r.emplace<EnemyShooter>(e, EnemyShooter{0.f, interval, 220.f, 0.60f});
-            }
+        float localX = cc * 36.f;
+        float localY = startY + rr * 36.f;
+        t = {980.f + localX, y + localY};
+        f = {origin, static_cast<std::uint16_t>(idx), localX, localY};
+        if (chance(rng_) < (int)shooterPercent_) {
+            float interval = (difficulty_ == 2 ? 1.0f : difficulty_ == 1 ? 1.3f : 1.7f);
+            cmd.emplace<EnemyShooter>(e, EnemyShooter{0.f, interval, 220.f, 0.60f});
         }
-    }
+        if (++rr == count) { rr = 0; ++cc; }
+    });
     return origin;
 }
 
 // Big enemies that also shoot at players
 rt::ecs::Entity FormationSpawnSystem::spawnBigShooters(rt::ecs::Registry& r, float y, int count) {
-    auto origin = r.create();
-    r.emplace<Transform>(origin, {980.f, y});
-    r.emplace<Velocity>(origin, {-40.f, 0.f});
-    r.emplace<Formation>(origin, {FormationType::Line, -40.f, 0.f, 0.f, 64.f, 0, 0});
+    auto& cmd = r.commands();
+    auto origin = cmd.create();
+    cmd.emplace<Transform>(origin, {980.f, y});
+    cmd.emplace<Velocity>(origin, {-40.f, 0.f});
+    cmd.emplace<Formation>(origin, {FormationType::Line, -40.f, 0.f, 0.f, 64.f, 0, 0});
     std::uniform_real_distribution<float> accd(0.5f, 0.8f);
-    for (int i = 0; i < count; ++i) {
-        auto e = r.create();
+    auto big = enemyPrefab(origin, -40.f, 0xAA3333FFu);
+    std::get<Size>(big.values) = {28.f, 20.f};
+    cmd.spawn(big, static_cast<std::size_t>(count), [&](std::size_t i, rt::ecs::Entity e, Transform& t, FormationFollower& f, auto&...) {
         float localX = i * 64.f;
-        r.emplace<Transform>(e, {980.f + localX, y});
-        r.emplace<Velocity>(e, {-40.f, 0.f});
-        r.emplace<NetType>(e, {static_cast<rtype::net::EntityType>(2)});
-        r.emplace<ColorRGBA>(e, {0xAA3333FFu});
-        r.emplace<EnemyTag>(e, {});
-        r.emplace<Size>(e, {28.f, 20.f});
-        r.emplace<FormationFollower>(e, {origin, static_cast<std::uint16_t>(i), localX, 0.f});
-        r.emplace<EnemyShooter>(e, {0.f, 1.2f, 240.f, accd(rng_)});
-    }
+        t = {980.f + localX, y};
+        f = {origin, static_cast<std::uint16_t>(i), localX, 0.f};
+        cmd.emplace<EnemyShooter>(e, {0.f, 1.2f, 240.f, accd(rng_)});
+    });
     return origin;
 }
 
 void FormationSpawnSystem::update(rt::ecs::Registry& r, float dt) {
     // Suppress regular waves while a boss is active
-    bool bossPresent = false;
-    for (auto& [e, _] : r.storage<BossTag>().data()) { (void)e; bossPresent = true; break; }
+    bool bossPresent = !r.storage<BossTag>().empty();
     if (bossPresent) {
         blockedByBoss_ = true;
         return;
@@ -388,8 +446,7 @@ void FormationSpawnSystem::update(rt::ecs::Registry& r, float dt) {
     if (timer_ < baseInterval_) return;
     timer_ = 0.f;
     // Limit to at most two active formations (origins)
-    int activeFormations = 0;
-    for (auto& [e, _] : r.storage<Formation>().data()) { (void)e; ++activeFormations; }
+    auto activeFormations = r.storage<Formation>().size();
     if (activeFormations >= 2) return;
     // World and margins
     constexpr float kWorldH = 600.f;
@@ -481,132 +538,231 @@ void FormationSpawnSystem::update(rt::ecs::Registry& r, float dt) {
     }
 }
 
+rt::ecs::Access FormationSpawnSystem::access() const {
+    return rt::ecs::Access{}
+        .read<BossTag>()
+        .write<Transform, Velocity, Formation, FormationFollower, NetType, ColorRGBA, EnemyTag, Size, EnemyShooter>()
+        .writeResource<std::mt19937>()
+        .structural();
+}
+
 void CollisionSystem::update(rt::ecs::Registry& r, float dt) {
     (void)dt;
-    // Gather bullets
-    std::vector<rt::ecs::Entity> bullets;
-    bullets.reserve(128);
-    for (auto& [e, _] : r.storage<BulletTag>().data()) bullets.push_back(e);
-
-    std::vector<rt::ecs::Entity> toDestroy;
-    auto intersects = [&](rt::ecs::Entity a, rt::ecs::Entity b){
-        auto* ta = r.get<Transform>(a); auto* sa = r.get<Size>(a);
-        auto* tb = r.get<Transform>(b); auto* sb = r.get<Size>(b);
-        if (!ta || !tb || !sa || !sb) return false;
-        float ax2 = ta->x + sa->w, ay2 = ta->y + sa->h;
-        float bx2 = tb->x + sb->w, by2 = tb->y + sb->h;
-        return !(ax2 < tb->x || bx2 < ta->x || ay2 < tb->y || by2 < ta->y);
+    // AABBs are snapshotted once per tick: nothing moves during collision
+    auto overlaps = [](const Box& a, const Box& b) {
+        return !(a.x2 < b.x || b.x2 < a.x || a.y2 < b.y || b.y2 < a.y);
+    };
+    // Enemies go to a per-tick index, item index == enemy order
+    enemies_.clear();
+    r.view<const EnemyTag, const Transform, const Size>().each(
+        [&](rt::ecs::Entity e, const EnemyTag&, const Transform& t, const Size& s) {
+        enemies_.insert(e, {t.x, t.y, t.x + s.w, t.y + s.h}, kEnemyLayer);
+    });
+    enemies_.build();
+    auto& players = players_;
+    players.clear();
+    r.view<const IsPlayer, const Transform, const Size>().each(
+        [&](rt::ecs::Entity e, const IsPlayer&, const Transform& t, const Size& s) {
+        players.push_back({e, t.x, t.y, t.x + s.w, t.y + s.h});
+    });
+
+    auto& cmd = r.commands();
+    auto& events = r.ctx<GameEvents>();
+    auto& bosses = r.storage<BossTag>();
+    const auto& beams = r.storage<BeamTag>();
+    const auto& owners = r.storage<BulletOwner>();
+    auto& scores = r.storage<Score>();
+
+    // Report the hit (the server takes the life) and apply a brief
+    // invincibility to prevent immediate re-hits
+    auto markHit = [&](rt::ecs::Entity p, rt::ecs::Entity by) {
+        events.push(PlayerHit{p, by});
+        grantInvincible(r, p, 1.0f);
+    };
+    // Credits the bullet's owner, if it still has a score
+    auto award = [&](rt::ecs::Entity bullet, std::int32_t points) {
+        if (auto* bo = owners.get(bullet)) {
+            if (auto* sc = scores.get(bo->owner)) {
+                sc->value += points;
+                return bo->owner;
+            }
+        }
+        return rt::ecs::kInvalidEntity;
     };
 
+    // Narrow phase in parallel: the first overlapping target of every bullet.
+    // Hits are then resolved sequentially in bullet order, since boss hp,
+    // scores and invincibility depend on it.
+    constexpr std::uint32_t kNoHit = rt::spatial::SpatialIndex::kNone;
+    auto& shots = shots_;
+    shots.clear();
+    r.view<const BulletTag, const Transform, const Size>().each(
+        [&](rt::ecs::Entity b, const BulletTag& bt, const Transform& t, const Size& s) {
+        shots.push_back({{b, t.x, t.y, t.x + s.w, t.y + s.h}, bt.faction, kNoHit});
+    });
+    auto detect = [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            auto& shot = shots[i];
+            if (shot.faction == BulletFaction::Player) {
+                // Lowest enemy index, so the first overlap matches a full scan
+                shot.first = enemies_.first({shot.box.x, shot.box.y, shot.box.x2, shot.box.y2}, kEnemyLayer);
+            } else {
+                for (std::uint32_t j = 0; j < players.size(); ++j) {
+                    if (overlaps(shot.box, players[j])) { shot.first = j; break; }
+                }
+            }
+        }
+    };
+    if (auto* jobs = r.jobs()) jobs->parallelFor(shots.size(), 0, detect);
+    else detect(0, shots.size());
+
     // Collide bullets with appropriate targets
-    for (auto b : bullets) {
-        auto* bt = r.get<BulletTag>(b);
-        if (!bt) continue;
-        bool isBeam = r.get<BeamTag>(b) != nullptr;
-        if (bt->faction == BulletFaction::Player) {
-            // hit enemies
-            for (auto& [e, _] : r.storage<EnemyTag>().data()) {
-                if (!intersects(b, e)) continue;
-                if (auto* boss = r.get<BossTag>(e)) {
+    auto& hits = hits_;
+    for (const auto& shot : shots) {
+        if (shot.first == kNoHit) continue;
+        const Box& bb = shot.box;
+        const rt::ecs::Entity b = bb.e;
+        bool isBeam = beams.contains(b);
+        if (shot.faction == BulletFaction::Player) {
+            // hit enemies; only beams go past the first hit
+            hits.assign(1, shot.first);
+            if (isBeam) {
+                hits.clear();
+                enemies_.queryAABB({bb.x, bb.y, bb.x2, bb.y2}, kEnemyLayer,
+                                   [&](std::uint32_t j, const auto&) { hits.push_back(j); });
+                std::sort(hits.begin(), hits.end());
+            }
+            for (auto j : hits) {
+                auto e = enemies_.item(j).entity;
+                if (auto* boss = bosses.get(e)) {
                     if (boss->hp > 0) boss->hp -= 1;
-                    if (!isBeam) toDestroy.push_back(b);
+                    if (!isBeam) cmd.destroy(b);
                     if (boss->hp <= 0) {
-                        if (auto* bo = r.get<BulletOwner>(b)) if (auto* sc = r.get<Score>(bo->owner)) sc->value += 1000;
-                        toDestroy.push_back(e);
+                        const auto killer = award(b, 1000);
+                        events.push(BossDefeated{e, killer, killer != rt::ecs::kInvalidEntity ? 1000 : 0});
+                        cmd.destroy(e);
                     }
                     if (!isBeam) break;
                     else continue;
                 }
-                if (auto* bo = r.get<BulletOwner>(b)) {
-                    if (auto* sc = r.get<Score>(bo->owner)) {
-                        sc->value += 50;
-                    }
-                }
-                if (!isBeam) toDestroy.push_back(b);
-                toDestroy.push_back(e);
+                const auto killer = award(b, 50);
+                events.push(EnemyKilled{e, killer, killer != rt::ecs::kInvalidEntity ? 50 : 0});
+                if (!isBeam) cmd.destroy(b);
+                cmd.destroy(e);
                 if (!isBeam) break;
             }
         } else {
             // enemy bullets hit players
-            for (auto& [e, _] : r.storage<IsPlayer>().data()) {
-                // players have IsPlayer component (and PlayerInput)
-                if (!intersects(b, e)) continue;
+            for (std::size_t j = shot.first; j < players.size(); ++j) {
+                const auto& pl = players[j];
+                if (!overlaps(bb, pl)) continue;
                 // If player is currently invincible, ignore this hit (but still destroy bullet)
-                if (auto* inv = r.get<Invincible>(e)) {
-                    if (inv->timeLeft > 0.f) { toDestroy.push_back(b); break; }
-                }
-                // Mark player as hit; server will process lives decrement
-                if (auto* hf = r.get<HitFlag>(e)) {
-                    hf->value = true;
-                } else {
-                    r.emplace<HitFlag>(e, {true});
-                }
-                // Apply a brief invincibility to prevent immediate re-hits
-                if (auto* inv = r.get<Invincible>(e)) {
-                    inv->timeLeft = std::max(inv->timeLeft, 1.0f);
-                } else {
-                    r.emplace<Invincible>(e, {1.0f});
-                }
-                toDestroy.push_back(b);
+                if (r.has<Invincible>(pl.e)) { cmd.destroy(b); break; }
+                markHit(pl.e, b);
+                cmd.destroy(b);
                 break;
             }
         }
     }
 
-    // Player-Enemy direct collision
-    for (auto& [player, _] : r.storage<IsPlayer>().data()) {
-        // Skip if player is invincible
-        if (auto* inv = r.get<Invincible>(player)) {
-            if (inv->timeLeft > 0.f) continue;
-        }
+    // Player-Enemy direct collision; invincible players are filtered out
+    r.view<const IsPlayer, const Transform, const Size>(rt::ecs::exclude<Invincible>).each(
+        [&](rt::ecs::Entity player, const IsPlayer&, const Transform& t, const Size& s) {
+        const Box pb{player, t.x, t.y, t.x + s.w, t.y + s.h};
+        // Only one collision per player per frame
+        const auto j = enemies_.first({pb.x, pb.y, pb.x2, pb.y2}, kEnemyLayer);
+        if (j == rt::spatial::SpatialIndex::kNone) return;
+        const auto enemy = enemies_.item(j).entity;
+        markHit(player, enemy);
+        // Destroy the enemy on collision; nobody scores or gets the kill
+        events.push(EnemyKilled{enemy, rt::ecs::kInvalidEntity, 0});
+        cmd.destroy(enemy);
+    });
+}
 
-        for (auto& [enemy, __] : r.storage<EnemyTag>().data()) {
-            if (intersects(player, enemy)) {
-                // Mark player as hit
-                if (auto* hf = r.get<HitFlag>(player)) {
-                    hf->value = true;
-                } else {
-                    r.emplace<HitFlag>(player, {true});
-                }
-                // Apply brief invincibility
-                if (auto* inv = r.get<Invincible>(player)) {
-                    inv->timeLeft = std::max(inv->timeLeft, 1.0f);
-                } else {
-                    r.emplace<Invincible>(player, {1.0f});
-                }
-                // Destroy the enemy on collision
-                toDestroy.push_back(enemy);
-                break; // Only one collision per player per frame
-            }
-        }
+rt::ecs::Access CollisionSystem::access() const {
+    return rt::ecs::Access{}.destroys().writeCtx<EffectTimers, GameEvents>().structural();
+}
+
+std::uint64_t rt::game::countdown(float& remaining, float step) {
+    std::uint64_t runs = 0;
+    do {
+        remaining -= step;
+        ++runs;
+    } while (remaining > 0.f);
+    return runs;
+}
+
+namespace {
+// A later grant that moved the expiry scheduled its own timer, so a timer
+// only ends the effect when it is the current one
+template <typename Effect>
+void grantEffect(rt::ecs::Registry& r, EffectClock& clock, rt::ecs::Entity e, float seconds) {
+    auto& wheel = clock.wheel;
+    const std::uint64_t due = wheel.now() + countdown(seconds, clock.step);
+    if (auto* fx = r.get<Effect>(e)) {
+        if (fx->expires >= due) return;
+        fx->expires = due;
+    } else {
+        r.emplace<Effect>(e, Effect{due});
     }
+    wheel.schedule(due, e);
+}
+
+template <typename Effect>
+void expireEffects(rt::ecs::Registry& r, EffectClock& clock, float dt) {
+    auto& wheel = clock.wheel;
+    clock.step = dt;
+    auto& cmd = r.commands();
+    const auto& effects = r.storage<Effect>();
+    wheel.advance([&](rt::ecs::Entity e, std::uint32_t) {
+        const auto* fx = effects.get(e);
+        if (fx && fx->expires == wheel.now()) cmd.remove<Effect>(e);
+    });
+}
+}
+
+void rt::game::grantInvincible(rt::ecs::Registry& r, rt::ecs::Entity e, float seconds) {
+    auto& timers = r.ctx<EffectTimers>();
+    grantEffect<Invincible>(r, timers.invincible, e, seconds);
+}
+
+void rt::game::grantInfiniteFire(rt::ecs::Registry& r, rt::ecs::Entity e, float seconds) {
+    auto& timers = r.ctx<EffectTimers>();
+    grantEffect<InfiniteFire>(r, timers.infiniteFire, e, seconds);
+}
+
+namespace {
+void pushDespawn(rt::ecs::Registry& r, rt::ecs::Entity e) {
+    r.ctx<GameEvents>().push(EntityDespawned{e, r.get<NetType>(e)->type});
+}
+}
 
-    for (auto e : toDestroy) r.destroy(e);
+void rt::game::trackDespawns(rt::ecs::Registry& r) {
+    r.onDestroy<NetType>().connect<&pushDespawn>();
 }
 
-// Decrement invincibility timers each frame
+// Expired invincibility is removed so that "not invincible" is expressible as
+// a view exclusion
 void InvincibilitySystem::update(rt::ecs::Registry& r, float dt) {
-    // Tick invincibility
-    auto& invs = r.storage<Invincible>().data();
-    for (auto& [e, inv] : invs) {
-        inv.timeLeft -= dt;
-        if (inv.timeLeft <= 0.f) {
-            inv.timeLeft = 0.f;
-        }
-    }
+    expireEffects<Invincible>(r, r.ctx<EffectTimers>().invincible, dt);
+}
+
+rt::ecs::Access InvincibilitySystem::access() const {
+    return rt::ecs::Access{}.write<Invincible>().writeCtx<EffectTimers>();
 }
 
 void BossSpawnSystem::update(rt::ecs::Registry& r, float dt) {
+    auto& cmd = r.commands();
     (void)dt;
     // Track whether a boss is currently present
-    bool anyBoss = false;
-    for (auto& [e, _] : r.storage<BossTag>().data()) { (void)e; anyBoss = true; break; }
+    bool anyBoss = !r.storage<BossTag>().empty();
     bossActive_ = anyBoss;
     if (anyBoss) return;
 
     // No boss present: decide whether to spawn based on score threshold multiples
     int bestScore = 0;
-    for (auto& [e, sc] : r.storage<Score>().data()) { (void)e; bestScore = std::max(bestScore, sc.value); }
+    for (const auto& sc : r.storage<Score>().components()) bestScore = std::max(bestScore, sc.value);
     if (threshold_ <= 0) return;
     int shouldHaveSpawned = bestScore / threshold_;
     if (shouldHaveSpawned <= bossesSpawned_) return; // not yet at next multiple
@@ -621,13 +777,13 @@ void BossSpawnSystem::update(rt::ecs::Registry& r, float dt) {
     float yMax = kWorldH - kBottomMargin - bh;
     if (yMax < yMin) yMax = yMin;
     float by = 0.5f * (yMin + yMax);
-    auto e = r.create();
-    r.emplace<Transform>(e, Transform{980.f + 60.f, by});
-    r.emplace<Velocity>(e, Velocity{-60.f, 0.f});
-    r.emplace<Size>(e, Size{bw, bh});
-    r.emplace<ColorRGBA>(e, ColorRGBA{0x9646B4FFu});
-    r.emplace<NetType>(e, NetType{static_cast<rtype::net::EntityType>(2)});
-    r.emplace<EnemyTag>(e, EnemyTag{});
+    auto e = cmd.create();
+    cmd.emplace<Transform>(e, Transform{980.f + 60.f, by});
+    cmd.emplace<Velocity>(e, Velocity{-60.f, 0.f});
+    cmd.emplace<Size>(e, Size{bw, bh});
+    cmd.emplace<ColorRGBA>(e, ColorRGBA{0x9646B4FFu});
+    cmd.emplace<NetType>(e, NetType{static_cast<rtype::net::EntityType>(2)});
+    cmd.emplace<EnemyTag>(e, EnemyTag{});
     BossTag boss{};
     boss.maxHp = 50;
     boss.hp = boss.maxHp;
@@ -638,22 +794,33 @@ void BossSpawnSystem::update(rt::ecs::Registry& r, float dt) {
     boss.dirDown = true;
     boss.speedX = -60.f;
     boss.speedY = 100.f;
-    r.emplace<BossTag>(e, boss);
+    cmd.emplace<BossTag>(e, boss);
 
     bossesSpawned_ += 1;
     bossActive_ = true;
 }
 
+rt::ecs::Access BossSpawnSystem::access() const {
+    return rt::ecs::Access{}
+        .read<BossTag, Score>()
+        .write<Transform, Velocity, Size, ColorRGBA, NetType, EnemyTag, BossTag>()
+        .structural();
+}
+
 void BossSystem::update(rt::ecs::Registry& r, float dt) {
     constexpr float kWorldH = 600.f;
     constexpr float kTopMargin = 56.f;
     constexpr float kBottomMargin = 10.f;
-    for (auto& [e, boss] : r.storage<BossTag>().data()) {
-        auto* t = r.get<Transform>(e);
-        auto* v = r.get<Velocity>(e);
-        auto* s = r.get<Size>(e);
-        if (!t || !s) continue;
-        if (!v) { r.emplace<Velocity>(e, Velocity{0.f, 0.f}); v = r.get<Velocity>(e); }
+    // Bosses spawn with a Velocity; one without gets it on the next flush, as
+    // emplacing it here would reorder the movement group under the loop
+    auto& cmd = r.commands();
+    r.view<const BossTag>(rt::ecs::exclude<Velocity>).each(
+        [&](rt::ecs::Entity e, const BossTag&) { cmd.emplace<Velocity>(e, Velocity{0.f, 0.f}); });
+    r.view<BossTag, Transform, Velocity, const Size>().each(
+        [&](BossTag& boss, Transform& tr, Velocity& vel, const Size& sz) {
+        auto* t = &tr;
+        auto* s = &sz;
+        auto* v = &vel;
         float minY = kTopMargin;
         float maxY = kWorldH - kBottomMargin - s->h;
         if (!boss.atStop) {
@@ -679,11 +846,16 @@ void BossSystem::update(rt::ecs::Registry& r, float dt) {
             if (t->y < minY) t->y = minY;
             if (t->y > maxY) t->y = maxY;
         }
-    }
+    });
+}
+
+rt::ecs::Access BossSystem::access() const {
+    return rt::ecs::Access{}.read<Size>().write<BossTag, Transform, Velocity>().structural();
 }
 
 // Spawn power-ups based on score thresholds
 void PowerupSpawnSystem::update(rt::ecs::Registry& r, float dt) {
+    auto& cmd = r.commands();
     (void)dt;
     if (!teamScore_) return;
 
@@ -706,12 +878,12 @@ void PowerupSpawnSystem::update(rt::ecs::Registry& r, float dt) {
         PowerupType type = static_cast<PowerupType>(tdist(rng_));
 
         // Create the power-up entity
-        auto pu = r.create();
-        r.emplace<Transform>(pu, Transform{x, y});
-        r.emplace<Velocity>(pu, Velocity{-powerupSpeed_, 0.f});
-        r.emplace<PowerupTag>(pu, PowerupTag{type});
-        r.emplace<NetType>(pu, NetType{rtype::net::EntityType::Powerup});
-        r.emplace<Size>(pu, Size{18.f, 18.f}); // radius ~9
+        auto pu = cmd.create();
+        cmd.emplace<Transform>(pu, Transform{x, y});
+        cmd.emplace<Velocity>(pu, Velocity{-powerupSpeed_, 0.f});
+        cmd.emplace<PowerupTag>(pu, PowerupTag{type});
+        cmd.emplace<NetType>(pu, NetType{rtype::net::EntityType::Powerup});
+        cmd.emplace<Size>(pu, Size{18.f, 18.f}); // radius ~9
 
         // Set color based on type
         std::uint32_t color = 0xFFFFFFFF;
@@ -721,7 +893,7 @@ void PowerupSpawnSystem::update(rt::ecs::Registry& r, float dt) {
             case PowerupType::ClearBoard:    color = 0xAA50C8FF; break; // purple
             case PowerupType::InfiniteFire:  color = 0xF0DC50FF; break; // yellow
         }
-        r.emplace<ColorRGBA>(pu, ColorRGBA{color});
+        cmd.emplace<ColorRGBA>(pu, ColorRGBA{color});
 
         // Schedule next power-up
         std::uniform_int_distribution<int> dd(powerupMinPts_, powerupMaxPts_);
@@ -729,103 +901,90 @@ void PowerupSpawnSystem::update(rt::ecs::Registry& r, float dt) {
     }
 }
 
+rt::ecs::Access PowerupSpawnSystem::access() const {
+    return rt::ecs::Access{}
+        .write<Transform, Velocity, PowerupTag, NetType, Size, ColorRGBA>()
+        .writeResource<std::mt19937>()
+        .structural();
+}
+
 // Handle power-up collision with players
 void PowerupCollisionSystem::update(rt::ecs::Registry& r, float dt) {
     (void)dt;
-    std::vector<rt::ecs::Entity> toDestroy;
-
-    // Helper to check AABB collision
-    auto intersects = [&r](rt::ecs::Entity a, rt::ecs::Entity b) -> bool {
-        auto* ta = r.get<Transform>(a);
-        auto* sa = r.get<Size>(a);
-        auto* tb = r.get<Transform>(b);
-        auto* sb = r.get<Size>(b);
-        if (!ta || !sa || !tb || !sb) return false;
-        float ax1 = ta->x, ay1 = ta->y, ax2 = ta->x + sa->w, ay2 = ta->y + sa->h;
-        float bx1 = tb->x, by1 = tb->y, bx2 = tb->x + sb->w, by2 = tb->y + sb->h;
-        return !(ax2 < bx1 || bx2 < ax1 || ay2 < by1 || by2 < ay1);
+    auto& cmd = r.commands();
+    auto& events = r.ctx<GameEvents>();
+
+    const auto& index = r.ctx<rt::spatial::SpatialIndex>();
+    const auto& inputs = r.storage<PlayerInput>();
+    const auto& sizes = r.storage<Size>();
+    auto canCollect = [&](std::uint32_t, const rt::spatial::SpatialIndex::Item& it) {
+        return inputs.contains(it.entity) && sizes.contains(it.entity);
     };
 
-    // Check each power-up against all players
-    auto& powerups = r.storage<PowerupTag>().data();
-    for (auto& [pu, tag] : powerups) {
-        bool collected = false;
-
-        for (auto& [player, _] : r.storage<PlayerInput>().data()) {
-            if (intersects(pu, player)) {
-                // Apply power-up effect
-                switch (tag.type) {
-                    case PowerupType::Life: {
-                        // Mark that this player should receive an extra life
-                        if (!r.get<LifePickup>(player)) {
-                            r.emplace<LifePickup>(player, LifePickup{true});
-                        }
-                        break;
-                    }
-                    case PowerupType::Invincibility: {
-                        // Grant 10 seconds of invincibility
-                        if (auto* inv = r.get<Invincible>(player)) {
-                            inv->timeLeft = std::max(inv->timeLeft, 10.0f);
-                        } else {
-                            r.emplace<Invincible>(player, Invincible{10.0f});
-                        }
-                        break;
-                    }
-                    case PowerupType::ClearBoard: {
-                        // Destroy all enemies on screen and award points
-                        std::vector<rt::ecs::Entity> enemiesToDestroy;
-                        for (auto& [e, _] : r.storage<EnemyTag>().data()) {
-                            enemiesToDestroy.push_back(e);
-                        }
-                        for (auto e : enemiesToDestroy) {
-                            toDestroy.push_back(e);
-                        }
-                        // Award score for cleared enemies
-                        if (auto* sc = r.get<Score>(player)) {
-                            sc->value += 50 * static_cast<int>(enemiesToDestroy.size());
-                        }
-                        break;
-                    }
-                    case PowerupType::InfiniteFire: {
-                        // Grant 10 seconds of infinite fire
-                        if (auto* inf = r.get<InfiniteFire>(player)) {
-                            inf->timeLeft = std::max(inf->timeLeft, 10.0f);
-                        } else {
-                            r.emplace<InfiniteFire>(player, InfiniteFire{10.0f});
-                        }
-                        break;
-                    }
+    // Check each power-up against the players sharing its cells
+    r.view<const PowerupTag, const Transform, const Size>().each(
+        [&](rt::ecs::Entity pu, const PowerupTag& tag, const Transform& pt, const Size& ps) {
+        const auto hit = index.first({pt.x, pt.y, pt.x + ps.w, pt.y + ps.h}, kPlayerLayer, canCollect);
+        if (hit == rt::spatial::SpatialIndex::kNone) return;
+        const rt::ecs::Entity player = index.item(hit).entity;
+        // Life is granted by the server when it drains the event
+        events.push(PowerupTaken{player, tag.type});
+
+        // Apply power-up effect
+        switch (tag.type) {
+            case PowerupType::Life:
+                break;
+            case PowerupType::Invincibility: {
+                // Grant 10 seconds of invincibility
+                grantInvincible(r, player, 10.0f);
+                break;
+            }
+            case PowerupType::ClearBoard: {
+                // Destroy all enemies on screen and award points
+                const auto& enemiesToDestroy = r.storage<EnemyTag>().entities();
+                for (auto e : enemiesToDestroy) {
+                    events.push(EnemyKilled{e, player, 50});
+                    cmd.destroy(e);
                 }
-
-                collected = true;
-                toDestroy.push_back(pu);
+                // Award score for cleared enemies
+                if (auto* sc = r.get<Score>(player)) {
+                    sc->value += 50 * static_cast<int>(enemiesToDestroy.size());
+                }
+                break;
+            }
+            case PowerupType::InfiniteFire: {
+                // Grant 10 seconds of infinite fire
+                grantInfiniteFire(r, player, 10.0f);
                 break;
             }
         }
 
-        if (collected) continue;
-    }
+        cmd.destroy(pu);
+    });
+}
 
-    for (auto e : toDestroy) {
-        r.destroy(e);
-    }
+rt::ecs::Access PowerupCollisionSystem::access() const {
+    return rt::ecs::Access{}.destroys().writeCtx<EffectTimers, GameEvents>().structural();
 }
 
-// Manage infinite fire timers and modify shooting behavior
+// Expire infinite fire and modify shooting behavior
 void InfiniteFireSystem::update(rt::ecs::Registry& r, float dt) {
-    auto& fires = r.storage<InfiniteFire>().data();
-    for (auto& [e, inf] : fires) {
-        inf.timeLeft -= dt;
-        if (inf.timeLeft <= 0.f) {
-            inf.timeLeft = 0.f;
+    auto& clock = r.ctx<EffectTimers>().infiniteFire;
+    expireEffects<InfiniteFire>(r, clock, dt);
+
+    // While infinite fire is active, override shooter cooldown; effects that
+    // expired just now are still in the pool until this system's flush
+    auto& shooters = r.storage<Shooter>();
+    const auto now = clock.wheel.now();
+    r.view<const InfiniteFire>().each([&](rt::ecs::Entity e, const InfiniteFire& inf) {
+        if (inf.expires == now) return;
+        if (auto* shooter = shooters.get(e)) {
+            shooter->cooldown = 0.f; // Always ready to shoot
         }
+    });
+}
 
-        // While infinite fire is active, override shooter cooldown
-        if (inf.timeLeft > 0.f) {
-            if (auto* shooter = r.get<Shooter>(e)) {
-                shooter->cooldown = 0.f; // Always ready to shoot
-            }
-        }
-    }
+rt::ecs::Access InfiniteFireSystem::access() const {
+    return rt::ecs::Access{}.write<InfiniteFire, Shooter>().writeCtx<EffectTimers>();
 }
 
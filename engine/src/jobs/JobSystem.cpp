@@ -0,0 +1,153 @@
+#include "rt/jobs/JobSystem.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+namespace rt::jobs {
+
+namespace {
+// Worker identity of the current thread, so nested submits stay local
+thread_local const JobSystem* tlsPool = nullptr;
+thread_local std::size_t tlsIndex = 0;
+
+std::size_t envSize(const char* name, std::size_t fallback) {
+    if (const char* v = std::getenv(name)) {
+        try {
+            return static_cast<std::size_t>(std::stoul(v));
+        } catch (...) {
+        }
+    }
+    return fallback;
+}
+}
+
+JobSystem::JobSystem(std::size_t workers, std::size_t chunk) : chunk_(chunk ? chunk : 1) {
+    for (std::size_t i = 0; i < workers; ++i) queues_.push_back(std::make_unique<Queue>());
+    threads_.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i) threads_.emplace_back([this, i] { workerLoop(i); });
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepM_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& t : threads_) t.join();
+}
+
+std::size_t JobSystem::defaultWorkers() {
+    auto hw = std::thread::hardware_concurrency();
+    return envSize("RTYPE_JOB_WORKERS", hw > 1 ? hw - 1 : 0);
+}
+
+std::size_t JobSystem::defaultChunk() { return envSize("RTYPE_JOB_CHUNK", kDefaultChunk); }
+
+void JobSystem::run(const std::vector<Task>& tasks) {
+    if (tasks.empty()) return;
+    if (threads_.empty()) {
+        for (const auto& t : tasks) t();
+        return;
+    }
+    std::vector<Item> items;
+    items.reserve(tasks.size());
+    for (const auto& t : tasks)
+        items.push_back({[](const void* ctx, std::size_t, std::size_t) { (*static_cast<const Task*>(ctx))(); },
+                         &t, 0, 0, nullptr});
+    Batch batch;
+    submit(items, batch);
+}
+
+void JobSystem::parallelFor(std::size_t count, std::size_t chunk, const void* ctx,
+                            void (*call)(const void* ctx, std::size_t begin, std::size_t end)) {
+    if (count == 0) return;
+    if (chunk == 0) chunk = chunk_;
+    if (threads_.empty() || count <= chunk) {
+        call(ctx, 0, count);
+        return;
+    }
+    std::vector<Item> items;
+    items.reserve((count + chunk - 1) / chunk);
+    for (std::size_t b = 0; b < count; b += chunk) items.push_back({call, ctx, b, std::min(count, b + chunk), nullptr});
+    Batch batch;
+    submit(items, batch);
+}
+
+// Queues the items (on the caller's own deque for workers, spread round-robin
+// otherwise), then helps until the whole batch has run
+void JobSystem::submit(const std::vector<Item>& items, Batch& batch) {
+    batch.pending = items.size();
+    queued_ += items.size();
+    const bool worker = tlsPool == this;
+    const std::size_t self = worker ? tlsIndex : queues_.size();
+    for (auto item : items) {
+        item.batch = &batch;
+        auto& q = worker ? *queues_[self] : *queues_[next_++ % queues_.size()];
+        std::lock_guard<std::mutex> lock(q.m);
+        q.items.push_back(item);
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepM_);
+    }
+    wake_.notify_all();
+
+    Item item;
+    while (batch.pending.load(std::memory_order_acquire) > 0) {
+        if (take(self, item)) execute(item);
+        else std::this_thread::yield();
+    }
+    if (batch.error) std::rethrow_exception(batch.error);
+}
+
+// Own deque first (newest work, LIFO), then steal the oldest work of others
+bool JobSystem::take(std::size_t self, Item& out) {
+    if (queued_.load(std::memory_order_acquire) == 0) return false;
+    if (self < queues_.size()) {
+        auto& q = *queues_[self];
+        std::lock_guard<std::mutex> lock(q.m);
+        if (!q.items.empty()) {
+            out = q.items.back();
+            q.items.pop_back();
+            --queued_;
+            return true;
+        }
+    }
+    for (std::size_t k = 1; k <= queues_.size(); ++k) {
+        auto& q = *queues_[(self + k) % queues_.size()];
+        std::lock_guard<std::mutex> lock(q.m);
+        if (!q.items.empty()) {
+            out = q.items.front();
+            q.items.pop_front();
+            --queued_;
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::execute(const Item& item) {
+    try {
+        item.call(item.ctx, item.begin, item.end);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(item.batch->m);
+        if (!item.batch->error) item.batch->error = std::current_exception();
+    }
+    item.batch->pending.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void JobSystem::workerLoop(std::size_t index) {
+    tlsPool = this;
+    tlsIndex = index;
+    Item item;
+    for (;;) {
+        if (take(index, item)) {
+            execute(item);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepM_);
+        wake_.wait(lock, [this] { return stop_ || queued_.load() > 0; });
+        if (stop_ && queued_.load() == 0) return;
+    }
+}
+
+}
@@ -0,0 +1,71 @@
+#include "rt/memory/FrameArena.hpp"
+#include <algorithm>
+#include <bit>
+#include <new>
+
+using namespace rt::memory;
+
+namespace {
+constexpr std::size_t kBlockAlign = alignof(std::max_align_t);
+
+std::size_t alignUp(std::size_t v, std::size_t align) { return (v + align - 1) & ~(align - 1); }
+}
+
+FrameArena::FrameArena(std::size_t capacity, std::pmr::memory_resource* upstream)
+    : upstream_(upstream), capacity_(capacity) {
+    if (capacity_ > 0) {
+        block_ = static_cast<std::byte*>(upstream_->allocate(capacity_, kBlockAlign));
+        ++upstreamAllocations_;
+    }
+}
+
+FrameArena::~FrameArena() {
+    releaseSpills();
+    if (block_) upstream_->deallocate(block_, capacity_, kBlockAlign);
+}
+
+void* FrameArena::do_allocate(std::size_t bytes, std::size_t align) {
+    // Aligned on the address, so any alignment works in a max_align_t block
+    const auto base = reinterpret_cast<std::uintptr_t>(block_);
+    const std::size_t start = alignUp(base + offset_, align) - base;
+    if (block_ && start + bytes <= capacity_) {
+        used_ += start + bytes - offset_;
+        offset_ = start + bytes;
+        return block_ + start;
+    }
+    return spill(bytes, align);
+}
+
+void* FrameArena::spill(std::size_t bytes, std::size_t align) {
+    align = std::max(align, kBlockAlign);
+    const std::size_t header = alignUp(sizeof(Spill), align);
+    const std::size_t total = header + bytes;
+    auto* raw = static_cast<std::byte*>(upstream_->allocate(total, align));
+    ++upstreamAllocations_;
+    spills_ = new (raw) Spill{spills_, total, align};
+    used_ += bytes;
+    return raw + header;
+}
+
+void FrameArena::releaseSpills() {
+    while (spills_) {
+        Spill* s = spills_;
+        spills_ = s->next;
+        upstream_->deallocate(s, s->bytes, s->align);
+    }
+}
+
+void FrameArena::reset() {
+    peak_ = std::max(peak_, used_);
+    if (spills_) {
+        releaseSpills();
+        // Room for the whole frame next time, with headroom for alignment
+        const std::size_t grown = std::bit_ceil(used_ + used_ / 8);
+        if (block_) upstream_->deallocate(block_, capacity_, kBlockAlign);
+        block_ = static_cast<std::byte*>(upstream_->allocate(grown, kBlockAlign));
+        capacity_ = grown;
+        ++upstreamAllocations_;
+    }
+    offset_ = 0;
+    used_ = 0;
+}
@@ -0,0 +1,123 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "rt/ecs/Types.hpp"
+#include "rt/ecs/Prefab.hpp"
+
+namespace rt::ecs {
+
+class Registry;
+
+// Records structural changes made while a system iterates and plays them back
+// in recording order at a sync point (Registry::update flushes after each
+// system). Entities from create() are live immediately, so their handle can be
+// stored in other components, but they only receive components on flush.
+// Payloads are staged in one typed vector per component, which lets playback
+// reserve every touched pool once.
+class CommandBuffer {
+  public:
+    explicit CommandBuffer(Registry& r) : r_(r) {}
+    CommandBuffer(const CommandBuffer&) = delete;
+    CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+    Entity create();
+
+    template <typename C>
+    void emplace(Entity e, C c = C{}) {
+        auto& s = staged<C>();
+        cmds_.push_back({e, static_cast<std::uint32_t>(s.items.size()), &applyEmplace<C>});
+        s.items.push_back(std::move(c));
+    }
+
+    // Deferred Registry::spawn: the handles are live and init() runs right
+    // away on the staged rows; the whole batch is one command on flush. init
+    // may record other commands, but not emplaces of the prefab's own types.
+    template <typename... Cs, typename F>
+    void spawn(const Prefab<Cs...>& prefab, std::size_t count, F&& init) {
+        if (count == 0) return;
+        auto stages = std::tie(staged<Cs>()...);
+        const auto batch = static_cast<std::uint32_t>(batches_.size());
+        batches_.push_back(static_cast<std::uint32_t>(count));
+        batches_.push_back(static_cast<std::uint32_t>(spawned_.size()));
+        (batches_.push_back(static_cast<std::uint32_t>(std::get<Staged<Cs>&>(stages).items.size())), ...);
+        for (std::size_t i = 0; i < count; ++i) spawned_.push_back(create());
+        cmds_.push_back({spawned_[batches_[batch + 1]], batch, &applySpawn<Cs...>});
+        for (std::size_t i = 0; i < count; ++i) {
+            auto row = prefab.values;
+            init(i, spawned_[batches_[batch + 1] + i], std::get<Cs>(row)...);
+            (std::get<Staged<Cs>&>(stages).items.push_back(std::move(std::get<Cs>(row))), ...);
+        }
+        std::size_t k = batch + 2;
+        if (((std::get<Staged<Cs>&>(stages).items.size() != batches_[k++] + count) || ...))
+            throw std::logic_error("rt::ecs::CommandBuffer: spawn init emplaced a prefab component");
+    }
+    template <typename... Cs>
+    void spawn(const Prefab<Cs...>& prefab, std::size_t count) {
+        spawn(prefab, count, [](std::size_t, Entity, Cs&...) {});
+    }
+
+    template <typename C>
+    void remove(Entity e) { cmds_.push_back({e, 0, &applyRemove<C>}); }
+
+    void destroy(Entity e) { cmds_.push_back({e, 0, &applyDestroy}); }
+
+    // Applies and clears every recorded command. Emplaces on entities that are
+    // no longer valid by then are dropped; repeated destroys are no-ops.
+    // Commands recorded during the flush, e.g. by signal listeners, are applied
+    // by the same flush after the ones already queued.
+    void flush();
+
+    bool empty() const { return cmds_.empty(); }
+    std::size_t size() const { return cmds_.size(); }
+    Registry& registry() const { return r_; }
+
+  private:
+    struct IStaged {
+        virtual ~IStaged() = default;
+        virtual void reserve(Registry& r) = 0;
+        virtual void clear() = 0;
+    };
+
+    template <typename C>
+    struct Staged : IStaged {
+        std::vector<C> items;
+        void reserve(Registry& r) override;
+        void clear() override { items.clear(); }
+    };
+
+    struct Command {
+        Entity e;
+        std::uint32_t slot; // index into the staged payloads (emplace) or batches_ (spawn)
+        void (*apply)(CommandBuffer&, Entity, std::uint32_t);
+    };
+
+    template <typename C>
+    Staged<C>& staged() {
+        auto id = componentId<C>();
+        if (id >= staged_.size()) staged_.resize(id + 1);
+        if (!staged_[id]) staged_[id] = std::make_unique<Staged<C>>();
+        return static_cast<Staged<C>&>(*staged_[id]);
+    }
+
+    template <typename C>
+    static void applyEmplace(CommandBuffer& cb, Entity e, std::uint32_t slot);
+    template <typename C>
+    static void applyRemove(CommandBuffer& cb, Entity e, std::uint32_t);
+    static void applyDestroy(CommandBuffer& cb, Entity e, std::uint32_t);
+    template <typename... Cs>
+    static void applySpawn(CommandBuffer& cb, Entity, std::uint32_t batch);
+
+    Registry& r_;
+    std::vector<Command> cmds_;
+    std::vector<std::unique_ptr<IStaged>> staged_; // indexed by componentId
+    // Per spawn: count, offset into spawned_, then the first staged slot of each component
+    std::vector<std::uint32_t> batches_;
+    std::vector<Entity> spawned_;
+};
+
+}
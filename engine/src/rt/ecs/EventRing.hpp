@@ -0,0 +1,60 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace rt::ecs {
+
+// FIFO of E for producers and a consumer that take turns on the registry
+// (systems push during update(), the owner drains afterwards). Storage is a
+// power-of-two ring that only grows when a push finds it full, so push() stops
+// allocating once the ring has seen its busiest tick. Usually kept in
+// registry.ctx<EventRing<E>>(); systems that push declare
+// writeCtx<EventRing<E>>().
+template <typename E>
+class EventRing {
+  public:
+    explicit EventRing(std::size_t capacity = 256) {
+        std::size_t n = 16;
+        while (n < capacity) n *= 2;
+        buf_.resize(n);
+    }
+
+    void push(const E& e) {
+        if (size() == buf_.size()) grow();
+        buf_[tail_++ & (buf_.size() - 1)] = e;
+    }
+
+    std::size_t size() const { return tail_ - head_; }
+    bool empty() const { return head_ == tail_; }
+    std::size_t capacity() const { return buf_.size(); }
+
+    // Calls fn(E&) on every pending event, oldest first, and leaves the ring
+    // empty; events pushed by fn are delivered by the same drain
+    template <typename F>
+    void drain(F&& fn) {
+        while (head_ != tail_) {
+            E e = std::move(buf_[head_++ & (buf_.size() - 1)]);
+            fn(e);
+        }
+        head_ = tail_ = 0;
+    }
+
+    void clear() { head_ = tail_ = 0; }
+
+  private:
+    void grow() {
+        std::vector<E> next(buf_.size() * 2);
+        for (std::size_t i = head_; i != tail_; ++i) next[i - head_] = std::move(buf_[i & (buf_.size() - 1)]);
+        tail_ -= head_;
+        head_ = 0;
+        buf_.swap(next);
+    }
+
+    std::vector<E> buf_;
+    std::size_t head_ = 0; // running counts; positions are taken mod capacity
+    std::size_t tail_ = 0;
+};
+
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include "rt/ecs/Types.hpp"
+#include "rt/ecs/Storage.hpp"
+#include "rt/ecs/View.hpp"
+
+namespace rt::ecs {
+
+// Entities owning every component of an owning group. The registry keeps them
+// at dense positions [0, size()) of each owned pool, in the same order, so a
+// walk is a lockstep scan of the pools with no lookups or membership checks.
+// Like a view, do not add or remove owned components while iterating.
+template <typename... Cs>
+class Group {
+    static_assert(sizeof...(Cs) > 0, "a group owns at least one component");
+
+  public:
+    Group(const std::size_t& len, storage_for_t<Cs>&... pools) : len_(&len), pools_(&pools...) {}
+
+    std::size_t size() const { return *len_; }
+    bool empty() const { return *len_ == 0; }
+    // Same as size(); lets rt::jobs::parallel_for split groups like views
+    std::size_t sizeHint() const { return *len_; }
+
+    // Owner of position i, and the packed component arrays themselves
+    Entity entity(std::size_t i) const { return std::get<0>(pools_)->entities()[i]; }
+    template <typename C>
+    auto* raw() const { return std::get<storage_for_t<C>*>(pools_)->components().data(); }
+
+    // fn(Entity, Cs&...) or fn(Cs&...)
+    template <typename F>
+    void each(F&& fn) const { each(0, size(), fn); }
+
+    // Stamps C of positions [first, last) after writes through raw<C>()
+    template <typename C>
+    void touch(std::size_t first, std::size_t last) const {
+        std::get<storage_for_t<C>*>(pools_)->touchRange(first, last);
+    }
+
+    // each() over group positions [first, last); non-const components are
+    // stamped as written
+    template <typename F>
+    void each(std::size_t first, std::size_t last, F&& fn) const {
+        if (last > size()) last = size();
+        if (first >= last) return;
+        detail::work.processed += last - first;
+        (touchIfMutable<Cs>(first, last), ...);
+        auto arrays = std::apply([](auto*... p) { return std::make_tuple(p->components().data()...); }, pools_);
+        const Entity* owners = std::get<0>(pools_)->entities().data();
+        for (std::size_t i = first; i < last; ++i) {
+            std::apply([&](auto*... a) {
+                if constexpr (std::is_invocable_v<F&, Entity, Cs&...>) fn(owners[i], a[i]...);
+                else fn(a[i]...);
+            }, arrays);
+        }
+    }
+
+  private:
+    template <typename C>
+    void touchIfMutable(std::size_t first, std::size_t last) const {
+        if constexpr (!std::is_const_v<C>) touch<C>(first, last);
+    }
+
+    const std::size_t* len_;
+    std::tuple<storage_for_t<Cs>*...> pools_;
+};
+
+}
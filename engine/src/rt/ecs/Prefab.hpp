@@ -0,0 +1,22 @@
+#pragma once
+#include <tuple>
+#include <utility>
+
+namespace rt::ecs {
+
+// Component archetype with default values, declared once and stamped out in
+// batches by Registry::spawn / CommandBuffer::spawn:
+//   static const Prefab<Transform, Velocity, Size> bullet{{}, {300.f, 0.f}, {6.f, 3.f}};
+//   cmd.spawn(bullet, 3, [&](std::size_t i, Entity, Transform& t, Velocity&, Size&) { t.y = i * 8.f; });
+// Every spawned entity gets a copy of `values` that init() can adjust.
+template <typename... Cs>
+struct Prefab {
+    static_assert(sizeof...(Cs) > 0, "a prefab needs at least one component");
+
+    Prefab() = default;
+    explicit Prefab(Cs... cs) : values(std::move(cs)...) {}
+
+    std::tuple<Cs...> values;
+};
+
+}
@@ -1,14 +1,25 @@
 #pragma once
-#include <unordered_map>
-#include <typeindex>
 #include <memory>
 #include <vector>
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <functional>
+#include <stdexcept>
 #include <utility>
 #include "rt/ecs/Types.hpp"
 #include "rt/ecs/Storage.hpp"
+#include "rt/ecs/View.hpp"
+#include "rt/ecs/Group.hpp"
+#include "rt/ecs/Signal.hpp"
+#include "rt/ecs/Prefab.hpp"
+#include "rt/ecs/CommandBuffer.hpp"
 #include "rt/ecs/System.hpp"
 
+namespace rt::jobs {
+class JobSystem;
+}
+
 namespace rt::ecs {
 
 class Registry;
@@ -31,8 +42,30 @@ class EntityHandle {
 
 class Registry {
   public:
+    Registry() = default;
+    // Command buffers keep a reference back to their registry
+    Registry(const Registry&) = delete;
+    Registry& operator=(const Registry&) = delete;
+
+    // Reuses a freed slot index when one is available (with its bumped
+    // generation), otherwise appends a new slot. Index 0 is never handed out so
+    // that kInvalidEntity stays invalid.
     EntityHandle create() {
-        Entity e = ++last_;
+        std::uint32_t index;
+        if (!free_.empty()) {
+            index = free_.back();
+            free_.pop_back();
+        } else {
+            if (slots_.size() > kEntityIndexMask)
+                throw std::length_error("rt::ecs::Registry: entity index space exhausted");
+            index = static_cast<std::uint32_t>(slots_.size());
+            slots_.push_back(makeEntity(index, 0));
+            alivePos_.push_back(kNotAlive);
+            signatures_.push_back(0);
+        }
+        Entity e = slots_[index];
+        ++detail::work.created;
+        alivePos_[index] = static_cast<std::uint32_t>(alive_.size());
         alive_.push_back(e);
         return EntityHandle(*this, e);
     }
@@ -41,55 +74,446 @@ class Registry {
 
     EntityHandle handle(Entity e) { return EntityHandle(*this, e); }
 
+    // True while `e` is the live handle of its slot
+    bool valid(Entity e) const {
+        auto index = entityIndex(e);
+        return index < slots_.size() && slots_[index] == e && alivePos_[index] != kNotAlive;
+    }
+
+    // Bitmask of the pools `e` belongs to (0 for stale handles)
+    Signature signature(Entity e) const {
+        return valid(e) ? signatures_[entityIndex(e)] : 0;
+    }
+
+    // True when `e` has every one of Cs; a single mask test on the signature and
+    // never creates pools
+    template <typename... Cs>
+    bool has(Entity e) const {
+        static_assert(sizeof...(Cs) > 0, "has<> needs at least one component");
+        if (!(bitOf<std::remove_const_t<Cs>>() && ...)) return false;
+        const Signature mask = (bitOf<std::remove_const_t<Cs>>() | ...);
+        return (signature(e) & mask) == mask;
+    }
+
+    // Visits only the pools named in the entity's signature; stale or repeated
+    // handles are ignored. onDestroy listeners all run before any removal.
     void destroy(Entity e) {
-        for (auto& [_, store] : stores_) store->remove(e);
-        alive_.erase(std::remove(alive_.begin(), alive_.end(), e), alive_.end());
+        if (!valid(e)) return;
+        ++detail::work.destroyed;
+        auto index = entityIndex(e);
+        for (Signature sig = signatures_[index] & destroyed_; sig; sig &= sig - 1)
+            publish(signals_[static_cast<std::size_t>(std::countr_zero(sig))].destroy, e);
+        if (signatures_[index] & owned_) leaveGroups(e, signatures_[index]);
+        for (Signature sig = signatures_[index]; sig; sig &= sig - 1)
+            pools_[static_cast<std::size_t>(std::countr_zero(sig))]->remove(e);
+        signatures_[index] = 0;
+        auto pos = alivePos_[index];
+        Entity moved = alive_.back();
+        alive_[pos] = moved;
+        alivePos_[entityIndex(moved)] = pos;
+        alive_.pop_back();
+        alivePos_[index] = kNotAlive;
+        slots_[index] = makeEntity(index, entityGeneration(e) + 1);
+        free_.push_back(index);
     }
 
+    // Pools are handed out for reading and iteration; adding or removing
+    // components must go through emplace()/remove() to keep signatures in sync.
     template <typename C>
     ComponentStorage<C>& storage() {
-        auto key = std::type_index(typeid(C));
-        auto it = stores_.find(key);
-        if (it == stores_.end()) {
-            auto ptr = std::make_unique<ComponentStorage<C>>();
-            auto raw = ptr.get();
-            stores_.emplace(key, std::move(ptr));
-            return *raw;
-        }
-        return *static_cast<ComponentStorage<C>*>(it->second.get());
+        if (auto* p = find<C>()) return *p;
+        return create<C>();
     }
 
+    // Adds or replaces C on `e`. A stale handle throws logic_error before any
+    // pool is touched: its index may already belong to a newer entity.
     template <typename C>
-    C& emplace(Entity e, const C& c = C{}) { return storage<C>().emplace(e, c); }
+    C& emplace(Entity e, const C& c = C{}) {
+        requireValid(e);
+        auto& out = storage<C>().emplace(e, c);
+        mark<C>(e);
+        return out;
+    }
 
     template <typename C, typename... Args>
-    C& emplace(Entity e, Args&&... args) { return storage<C>().emplace(e, C{std::forward<Args>(args)...}); }
+    C& emplace(Entity e, Args&&... args) {
+        requireValid(e);
+        auto& c = storage<C>().emplace(e, C{std::forward<Args>(args)...});
+        mark<C>(e);
+        return c;
+    }
 
+    // `count` new entities built from `prefab`: init(i, Entity, Cs&...) adjusts
+    // the i-th copy of its values before they are inserted. Every pool is
+    // reserved once for the whole batch, and each entity's signature, groups
+    // and onConstruct listeners are updated once, after all its components.
+    template <typename... Cs, typename F>
+    void spawn(const Prefab<Cs...>& prefab, std::size_t count, F&& init) {
+        (reserve<Cs>(count), ...);
+        for (std::size_t i = 0; i < count; ++i) {
+            const Entity e = create();
+            auto row = prefab.values;
+            init(i, e, std::get<Cs>(row)...);
+            insertRow(e, std::move(std::get<Cs>(row))...);
+        }
+    }
+    template <typename... Cs>
+    void spawn(const Prefab<Cs...>& prefab, std::size_t count) {
+        spawn(prefab, count, [](std::size_t, Entity, Cs&...) {});
+    }
+
+    // Room for `extra` more C components, growing geometrically
     template <typename C>
-    C* get(Entity e) { return storage<C>().get(e); }
+    void reserve(std::size_t extra) {
+        auto& pool = storage<C>();
+        auto need = pool.size() + extra;
+        if (need > pool.capacity()) pool.reserve(std::max(need, pool.capacity() * 2));
+    }
 
+    // Does not create the pool when C was never used
     template <typename C>
-    auto& all() { return storage<C>().data(); }
+    C* get(Entity e) {
+        auto* p = find<C>();
+        return p ? p->get(e) : nullptr;
+    }
+
     template <typename C>
-    auto& getAll() { return storage<C>().data(); }
+    void remove(Entity e) {
+        auto* p = find<C>();
+        if (!p || !p->contains(e)) return;
+        if (destroyed_ & bitOf<C>()) publish(signals_[componentId<C>()].destroy, e);
+        if (owned_ & bitOf<C>()) leaveGroups(e, bitOf<C>());
+        p->remove(e);
+        if (valid(e)) signatures_[entityIndex(e)] &= ~bitOf<C>();
+    }
+
+    // Lifecycle signals per component type: onConstruct after C is added,
+    // onUpdate after emplace() replaces it or touch() stamps it (not on plain
+    // mutable access), onDestroy before it is removed or its entity destroyed.
+    // Listeners take (Registry&, Entity) and must not add/remove components or
+    // destroy entities; record such changes into commands(). A signal without
+    // listeners costs one mask test.
+    template <typename C>
+    Sink onConstruct() { return sink<C>(&Signals::construct, constructed_); }
+    template <typename C>
+    Sink onUpdate() { return sink<C>(&Signals::update, updated_); }
     template <typename C>
-    auto& getall() { return storage<C>().data(); }
+    Sink onDestroy() { return sink<C>(&Signals::destroy, destroyed_); }
 
-    void addSystem(std::unique_ptr<System> sys) { systems_.push_back(std::move(sys)); }
+    // Entities having all of Cs (optionally none of exclude<Ex...>), e.g.
+    // view<Transform, const Velocity>() or view<IsPlayer>(exclude<Invincible>)
+    template <typename... Cs, typename... Ex>
+    View<exclude_t<Ex...>, Cs...> view(exclude_t<Ex...> = {}) {
+        return View<exclude_t<Ex...>, Cs...>(storage<std::remove_const_t<Cs>>()..., storage<Ex>()...);
+    }
+
+    // Owning group over Cs: entities having all of them are kept at the front
+    // of each owned pool, index-aligned (see Group). The first call sorts the
+    // pools once; from then on emplace/remove/destroy maintain it with O(1)
+    // swaps. Groups sharing a pool must be nested, e.g. <Transform, Velocity>
+    // and <Transform, Velocity, NetType>; anything else throws logic_error.
+    template <typename... Cs>
+    Group<Cs...> group() {
+        const Signature mask = (bitOf<std::remove_const_t<Cs>>() | ...);
+        auto* g = findGroup(mask);
+        if (!g) g = &addGroup(mask, {&storage<std::remove_const_t<Cs>>()...});
+        return Group<Cs...>(g->len, storage<std::remove_const_t<Cs>>()...);
+    }
 
-    void update(float dt) {
-        for (auto& s : systems_) s->update(*this, dt);
+    // Per-registry instance of T, default-constructed on first use: state
+    // shared between systems (e.g. a spatial index) rather than per entity.
+    // A first use grows the table, so systems declare it (Access::readCtx /
+    // writeCtx) to have plan() create it before any parallel wave.
+    template <typename T>
+    T& ctx() {
+        auto id = resourceId<T>();
+        if (id >= ctx_.size()) ctx_.resize(id + 1);
+        if (!ctx_[id]) ctx_[id] = std::make_shared<T>();
+        return *static_cast<T*>(ctx_[id].get());
     }
 
+    // Change tracking: components are stamped with tick() when emplaced,
+    // touched, or walked as non-const group components; get() and views do
+    // not stamp. Nothing in the tree reads the stamps yet. update()
+    // starts a new tick; a consumer outside update() calls advanceTick() once
+    // done, so its own writes stay at or below the tick it keeps and every
+    // later write is newer.
+    std::uint32_t tick() const { return tick_; }
+    // Ends the current tick and returns it
+    std::uint32_t advanceTick() { return tick_++; }
+
+    template <typename C>
+    void touch(Entity e) {
+        auto* p = find<C>();
+        if (!p || !p->contains(e)) return;
+        p->touch(e);
+        if (updated_ & bitOf<C>()) publish(signals_[componentId<C>()].update, e);
+    }
+
+    // fn(Entity, C&) for every C written after tick `since`, in pool order: a
+    // linear scan of the pool's stamps. Writes through the reference are the
+    // caller's own and are not stamped.
+    template <typename C, typename F>
+    void changed(std::uint32_t since, F&& fn) {
+        auto* p = find<std::remove_const_t<C>>();
+        if (!p) return;
+        const auto& versions = p->versions();
+        auto& components = p->components();
+        for (std::size_t i = 0; i < versions.size(); ++i) {
+            if (versions[i] <= since) continue;
+            fn(p->entities()[i], static_cast<C&>(components[i]));
+        }
+    }
+
+    template <typename C>
+    auto all() { return storage<C>().data(); }
+    template <typename C>
+    auto getAll() { return storage<C>().data(); }
+    template <typename C>
+    auto getall() { return storage<C>().data(); }
+
+    void addSystem(std::unique_ptr<System> sys, Schedule schedule = {}) {
+        sys->attach(*this);
+        systems_.push_back(std::move(sys));
+        buffers_.push_back(std::make_unique<CommandBuffer>(*this));
+        if (schedule.every == 0) schedule.every = 1;
+        if (schedule.slices == 0) schedule.slices = 1;
+        runs_.push_back({schedule, 0.f, 0, {}});
+        waves_.clear();
+    }
+
+    // One entry per system, in registration order
+    std::vector<SystemStats> systemStats() const;
+    void resetSystemStats();
+
+    // Credits n entities to the running system's stats, for loops that walk
+    // pools or group arrays directly instead of through each()
+    static void countProcessed(std::size_t n) { detail::work.processed += n; }
+
+    // Part of its entities the running system should handle (all of them
+    // unless it was added with Schedule::slices). Entities moving within the
+    // pool between runs may be seen twice or skipped for one round.
+    Slice slice() const { return current_ && &current_->registry() == this ? currentSlice_ : Slice{}; }
+
+    // Worker pool used by update(); null (the default) runs systems one by one
+    void setJobs(rt::jobs::JobSystem* jobs) { jobs_ = jobs; }
+    rt::jobs::JobSystem* jobs() const { return jobs_; }
+
+    // Deferred structural changes. Inside update() each system records into its
+    // own buffer, flushed right after it returns; elsewhere this is the
+    // registry's buffer, flushed by flush() and at the start of update().
+    CommandBuffer& commands() {
+        if (current_ && &current_->registry() == this) return *current_;
+        return commands_;
+    }
+
+    void flush() { commands_.flush(); }
+
+    // Runs every system due this tick (see Schedule), in registration order,
+    // with the dt accumulated since its previous run. With a job system set,
+    // systems are grouped into waves of mutually non-conflicting Access (a
+    // system never moves ahead of an earlier one it conflicts with) and each
+    // wave runs in parallel; command buffers are still flushed in registration
+    // order, so the outcome matches the sequential run.
+    void update(float dt);
+
+    // Live handles, in no particular order (destroy swaps with the back)
     const std::vector<Entity>& alive() const { return alive_; }
 
+    // Checkpoint of the entities and every component pool, for rollback,
+    // replay keyframes or state dumps. Trivially copyable pools are saved with
+    // a memcpy of their dense arrays; reusing one Snapshot reuses its buffers.
+    class Snapshot {
+      public:
+        std::size_t entities() const { return alive_.size(); }
+        std::uint32_t tick() const { return tick_; }
+
+      private:
+        friend class Registry;
+        std::vector<Entity> slots_, alive_;
+        std::vector<std::uint32_t> alivePos_, free_;
+        std::vector<Signature> signatures_;
+        std::vector<PoolImage> pools_;                          // indexed by componentId
+        std::vector<std::pair<Signature, std::size_t>> groups_; // owned mask, len
+        std::uint32_t tick_ = 0;
+    };
+
+    void snapshot(Snapshot& out) const;
+    Snapshot snapshot() const {
+        Snapshot s;
+        snapshot(s);
+        return s;
+    }
+
+    // Puts entities and components back as they were in `s`, which may come
+    // from another registry. Handles stay valid exactly as they were then;
+    // stamps are restored but tick() never goes back. No signals fire, and
+    // systems, ctx() state and pending commands are left alone (flush first).
+    void restore(const Snapshot& s);
+
   private:
-    Entity last_ = 0;
+    static constexpr std::uint32_t kNotAlive = ~std::uint32_t{0};
+
+    // Binds the calling thread's command buffer and slice for the duration of
+    // a system
+    struct Bind {
+        Bind(CommandBuffer* cb, Slice slice) : prev(current_), prevSlice(currentSlice_) {
+            current_ = cb;
+            currentSlice_ = slice;
+        }
+        ~Bind() {
+            current_ = prev;
+            currentSlice_ = prevSlice;
+        }
+        CommandBuffer* prev;
+        Slice prevSlice;
+    };
+    static inline thread_local CommandBuffer* current_ = nullptr;
+    static inline thread_local Slice currentSlice_{};
+
+    // Timings and work of one system; a run is recorded once its commands
+    // are flushed
+    struct Profile {
+        std::array<std::uint32_t, SystemStats::kWindow> samples{}; // ns, ring
+        std::uint64_t runs = 0;
+        std::uint64_t totalNs = 0;
+        std::uint64_t pendingNs = 0; // update() time of the run awaiting its flush
+        detail::WorkCounters work;
+    };
+
+    struct Run {
+        Schedule schedule;
+        float elapsed;     // dt summed since the last run
+        std::uint64_t runs;
+        Profile profile;
+    };
+
+    // Adds dt to every system's pending time; true when system i runs this frame
+    bool due(std::size_t i, float dt) {
+        auto& run = runs_[i];
+        run.elapsed += dt;
+        return frame_ % run.schedule.every == run.schedule.phase % run.schedule.every;
+    }
+    void runSystem(std::size_t i);
+    // Books a finished run (update() and flush) of system i: its time and the
+    // work this thread did since `before`
+    void record(std::size_t i, std::uint64_t ns, const detail::WorkCounters& before);
+    void plan();
+
+    // Pool of C or nullptr: one bounds check and one indexed load
+    template <typename C>
+    ComponentStorage<C>* find() const {
+        auto id = componentId<C>();
+        return id < pools_.size() ? static_cast<ComponentStorage<C>*>(pools_[id].get()) : nullptr;
+    }
+
+    template <typename C>
+    ComponentStorage<C>& create() {
+        auto id = componentId<C>();
+        if (id >= kMaxComponents)
+            throw std::length_error("rt::ecs::Registry: more than 64 component types");
+        if (id >= pools_.size()) pools_.resize(id + 1);
+        auto ptr = std::make_unique<ComponentStorage<C>>(&tick_);
+        auto raw = ptr.get();
+        pools_[id] = std::move(ptr);
+        return *raw;
+    }
+
+    // 0 for ids past the signature width (such types can never get a pool)
+    template <typename C>
+    static Signature bitOf() {
+        auto id = componentId<C>();
+        return id < kMaxComponents ? Signature{1} << id : 0;
+    }
+
+    void requireValid(Entity e) const {
+        if (!valid(e)) throw std::logic_error("rt::ecs::Registry: emplace on a destroyed entity");
+    }
+
+    template <typename C>
+    void mark(Entity e) {
+        auto& sig = signatures_[entityIndex(e)];
+        const bool added = !(sig & bitOf<C>());
+        sig |= bitOf<C>();
+        if (added && (owned_ & bitOf<C>())) enterGroups(e);
+        if ((added ? constructed_ : updated_) & bitOf<C>()) {
+            const auto& s = signals_[componentId<C>()];
+            publish(added ? s.construct : s.update, e);
+        }
+    }
+
+    // emplace() of a whole component row: the signature is updated with one
+    // mask and groups are entered once all of Cs are in
+    template <typename... Cs>
+    void insertRow(Entity e, Cs&&... cs) {
+        if (!valid(e)) return;
+        (storage<std::decay_t<Cs>>().emplace(e, std::forward<Cs>(cs)), ...);
+        auto& sig = signatures_[entityIndex(e)];
+        const Signature mask = (bitOf<std::decay_t<Cs>>() | ...);
+        const Signature added = mask & ~sig;
+        sig |= mask;
+        if (added & owned_) enterGroups(e);
+        for (Signature s = added & constructed_; s; s &= s - 1)
+            publish(signals_[static_cast<std::size_t>(std::countr_zero(s))].construct, e);
+        for (Signature s = mask & ~added & updated_; s; s &= s - 1)
+            publish(signals_[static_cast<std::size_t>(std::countr_zero(s))].update, e);
+    }
+
+    struct Signals {
+        std::vector<Delegate> construct, update, destroy;
+    };
+
+    template <typename C>
+    Sink sink(std::vector<Delegate> Signals::*which, Signature& listened) {
+        storage<C>(); // the bit must exist
+        auto id = componentId<C>();
+        if (id >= signals_.size()) signals_.resize(id + 1);
+        return Sink(signals_[id].*which, listened, bitOf<C>());
+    }
+
+    void publish(const std::vector<Delegate>& listeners, Entity e) {
+        for (const auto& d : listeners) d.call(d.instance, *this, e);
+    }
+
+    struct GroupData {
+        Signature owned;
+        std::size_t len;              // members sit at [0, len) of every pool
+        std::vector<IStorage*> pools;
+    };
+
+    GroupData* findGroup(Signature mask) const {
+        for (const auto& g : groups_)
+            if (g->owned == mask) return g.get();
+        return nullptr;
+    }
+    GroupData& addGroup(Signature mask, std::vector<IStorage*> pools);
+    void enterGroups(Entity e);
+    void leaveGroups(Entity e, Signature lost);
+
+    std::vector<Entity> slots_{kInvalidEntity};      // current handle per index (0 reserved)
+    std::vector<std::uint32_t> alivePos_{kNotAlive}; // index -> position in alive_
+    std::vector<std::uint32_t> free_;                // recycled indices (LIFO)
+    std::vector<Signature> signatures_{0};           // index -> pools it belongs to
     std::vector<Entity> alive_;
-    std::unordered_map<std::type_index, std::unique_ptr<IStorage>> stores_;
+    std::vector<std::unique_ptr<IStorage>> pools_;   // indexed by componentId (null if unused)
+    std::vector<std::shared_ptr<void>> ctx_;         // indexed by resourceId
+    std::vector<std::unique_ptr<GroupData>> groups_; // outer (fewer components) first
+    Signature owned_ = 0;                            // pools owned by some group
+    std::uint32_t tick_ = 1;                         // change stamp (0 = never)
+    std::vector<Signals> signals_;                   // indexed by componentId
+    Signature constructed_ = 0, updated_ = 0, destroyed_ = 0; // signals with listeners
     std::vector<std::unique_ptr<System>> systems_;
+    std::vector<std::unique_ptr<CommandBuffer>> buffers_; // one per system
+    std::vector<Run> runs_;                               // one per system
+    std::uint64_t frame_ = 0;                             // update() calls
+    std::vector<std::vector<std::size_t>> waves_;          // system indices, rebuilt lazily
+    std::vector<char> due_;                               // update() scratch: systems running this tick
+    std::vector<std::function<void()>> tasks_;            // update() scratch: one wave's tasks
+    rt::jobs::JobSystem* jobs_ = nullptr;
+    CommandBuffer commands_{*this};
 
     friend class EntityHandle;
+    friend class CommandBuffer;
 };
 
 template <typename C, typename... Args>
@@ -101,4 +525,59 @@ inline EntityHandle& EntityHandle::add(Args&&... args) {
 template <typename C>
 inline C* EntityHandle::get() { return r_.get<C>(e_); }
 
+template <typename C>
+void ensurePool(Registry& r) { r.storage<C>(); }
+
+template <typename T>
+void ensureCtx(Registry& r) { r.ctx<T>(); }
+
+inline Entity CommandBuffer::create() { return r_.create(); }
+
+inline void CommandBuffer::flush() {
+    for (auto& s : staged_)
+        if (s) s->reserve(r_);
+    // By index, and each command copied out: listeners may record commands
+    // while these apply, growing cmds_; those run in this same flush
+    for (std::size_t i = 0; i < cmds_.size(); ++i) {
+        const Command c = cmds_[i];
+        c.apply(*this, c.e, c.slot);
+    }
+    cmds_.clear();
+    batches_.clear();
+    spawned_.clear();
+    for (auto& s : staged_)
+        if (s) s->clear();
+}
+
+template <typename C>
+inline void CommandBuffer::Staged<C>::reserve(Registry& r) {
+    if (!items.empty()) r.reserve<C>(items.size());
+}
+
+template <typename C>
+inline void CommandBuffer::applyEmplace(CommandBuffer& cb, Entity e, std::uint32_t slot) {
+    if (!cb.r_.valid(e)) return;
+    cb.r_.emplace<C>(e, std::move(static_cast<Staged<C>&>(*cb.staged_[componentId<C>()]).items[slot]));
+}
+
+template <typename C>
+inline void CommandBuffer::applyRemove(CommandBuffer& cb, Entity e, std::uint32_t) { cb.r_.remove<C>(e); }
+
+inline void CommandBuffer::applyDestroy(CommandBuffer& cb, Entity e, std::uint32_t) { cb.r_.destroy(e); }
+
+template <typename... Cs>
+inline void CommandBuffer::applySpawn(CommandBuffer& cb, Entity, std::uint32_t batch) {
+    // batches_[batch + 2 + I] is the first staged slot of the I-th component.
+    // Everything is indexed afresh per row: onConstruct listeners may record
+    // commands that grow the staged vectors under us.
+    const std::uint32_t count = cb.batches_[batch];
+    for (std::uint32_t i = 0; i < count; ++i) {
+        const Entity e = cb.spawned_[cb.batches_[batch + 1] + i];
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            cb.r_.insertRow(e, std::move(static_cast<Staged<Cs>&>(*cb.staged_[componentId<Cs>()])
+                                             .items[cb.batches_[batch + 2 + I] + i])...);
+        }(std::index_sequence_for<Cs...>{});
+    }
+}
+
 }
@@ -0,0 +1,58 @@
+#pragma once
+#include <algorithm>
+#include <vector>
+#include "rt/ecs/Types.hpp"
+
+namespace rt::ecs {
+
+class Registry;
+
+// Listener of a registry lifecycle signal: a function pointer plus an optional
+// instance, so publishing never allocates or goes through std::function
+struct Delegate {
+    void (*call)(void* instance, Registry& r, Entity e);
+    void* instance;
+    bool operator==(const Delegate&) const = default;
+};
+
+// Connection point for one signal of one component type, handed out by
+// Registry::onConstruct/onUpdate/onDestroy. Use it right away: it refers into
+// the registry's listener tables.
+class Sink {
+  public:
+    Sink(std::vector<Delegate>& listeners, Signature& listened, Signature bit)
+        : listeners_(listeners), listened_(listened), bit_(bit) {}
+
+    // Free function: void fn(Registry&, Entity)
+    template <auto Fn>
+    void connect() { add({&freeStub<Fn>, nullptr}); }
+    // Member function: void T::fn(Registry&, Entity), called on `instance`
+    template <auto Fn, typename T>
+    void connect(T* instance) { add({&memberStub<Fn, T>, instance}); }
+
+    template <auto Fn>
+    void disconnect() { drop({&freeStub<Fn>, nullptr}); }
+    template <auto Fn, typename T>
+    void disconnect(T* instance) { drop({&memberStub<Fn, T>, instance}); }
+
+  private:
+    template <auto Fn>
+    static void freeStub(void*, Registry& r, Entity e) { Fn(r, e); }
+    template <auto Fn, typename T>
+    static void memberStub(void* instance, Registry& r, Entity e) { (static_cast<T*>(instance)->*Fn)(r, e); }
+
+    void add(Delegate d) {
+        if (std::find(listeners_.begin(), listeners_.end(), d) == listeners_.end()) listeners_.push_back(d);
+        listened_ |= bit_;
+    }
+    void drop(Delegate d) {
+        listeners_.erase(std::remove(listeners_.begin(), listeners_.end(), d), listeners_.end());
+        if (listeners_.empty()) listened_ &= ~bit_;
+    }
+
+    std::vector<Delegate>& listeners_;
+    Signature& listened_;
+    Signature bit_;
+};
+
+}
@@ -1,34 +1,253 @@
 #pragma once
-#include <unordered_map>
-#include <typeindex>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include "rt/ecs/Types.hpp"
 
 namespace rt::ecs {
 
+struct IStorage;
+
+// Copy of one pool's dense arrays (see Registry::Snapshot). Owners and stamps
+// are raw bytes, followed by the components when they are trivially copyable;
+// other types (e.g. Name) are copied element-wise into `objects`. Buffers are
+// reused when the same image is saved into again.
+struct PoolImage {
+    std::size_t size = 0;
+    std::vector<std::byte> bytes;
+    std::shared_ptr<void> objects; // std::vector<C> on the slow path
+    std::unique_ptr<IStorage> (*make)(const std::uint32_t* clock) = nullptr; // empty pool of the same type
+};
+
 struct IStorage {
     virtual ~IStorage() = default;
     virtual void remove(Entity e) = 0;
+    // Dense position of `e`, or ~0u
+    virtual std::uint32_t index(Entity e) const = 0;
+    virtual void swapAt(std::uint32_t i, std::uint32_t j) = 0;
+    virtual void save(PoolImage& out) const = 0;
+    // Replaces the whole pool with `in` (an empty image clears it)
+    virtual void load(const PoolImage& in) = 0;
 };
 
+// Sparse-set storage: components are packed in a dense array, next to a dense
+// array of their owners. A paged sparse table maps an entity index to its dense
+// slot, so lookups are two indexed loads and removal is an O(1) swap with the
+// back. The owner check rejects stale handles of a recycled index.
+// Every component carries the tick it was last written at (emplace or touch),
+// read from the clock the registry hands in; 0 without a clock.
 template <typename C>
 class ComponentStorage : public IStorage {
   public:
+    static constexpr std::size_t kPageSize = 1024;
+    static constexpr std::uint32_t kNull = ~std::uint32_t{0};
+
+    explicit ComponentStorage(const std::uint32_t* clock = nullptr) : clock_(clock) {}
+
+    // Iterable range of (entity, component&) pairs over the dense arrays, so
+    // `for (auto& [e, c] : storage.data())` walks contiguous memory.
+    template <typename Comp>
+    class Pairs {
+      public:
+        using value_type = std::pair<Entity, Comp&>;
+
+        class iterator {
+          public:
+            iterator(const Entity* e, Comp* c) : e_(e), c_(c) {}
+            value_type& operator*() { cur_.emplace(*e_, *c_); return *cur_; }
+            iterator& operator++() { ++e_; ++c_; return *this; }
+            bool operator!=(const iterator& o) const { return e_ != o.e_; }
+            bool operator==(const iterator& o) const { return e_ == o.e_; }
+          private:
+            const Entity* e_;
+            Comp* c_;
+            std::optional<value_type> cur_;
+        };
+
+        Pairs(const Entity* e, Comp* c, std::size_t n) : e_(e), c_(c), n_(n) {}
+        iterator begin() const { return iterator(e_, c_); }
+        iterator end() const { return iterator(e_ + n_, c_ + n_); }
+        std::size_t size() const { return n_; }
+        bool empty() const { return n_ == 0; }
+
+      private:
+        const Entity* e_;
+        Comp* c_;
+        std::size_t n_;
+    };
+
+    bool contains(Entity e) const { return slot(e) != kNull; }
+
+    std::uint32_t index(Entity e) const override { return slot(e); }
+
+    // Not stamped, so lookups stay two loads; a writer that changed() should
+    // see calls touch()
     C* get(Entity e) {
-        auto it = data_.find(e);
-        return it == data_.end() ? nullptr : &it->second;
+        auto i = slot(e);
+        return i == kNull ? nullptr : &dense_[i];
     }
     const C* get(Entity e) const {
-        auto it = data_.find(e);
-        return it == data_.end() ? nullptr : &it->second;
+        auto i = slot(e);
+        return i == kNull ? nullptr : &dense_[i];
     }
-    C& emplace(Entity e, const C& c = C{}) { return data_[e] = c; }
-    void remove(Entity e) override { data_.erase(e); }
-    std::unordered_map<Entity, C>& data() { return data_; }
-    const std::unordered_map<Entity, C>& data() const { return data_; }
+
+    C& emplace(Entity e, const C& c = C{}) { return insert(e, c); }
+    C& emplace(Entity e, C&& c) { return insert(e, std::move(c)); }
+
+    void remove(Entity e) override {
+        auto i = slot(e);
+        if (i == kNull) return;
+        auto last = static_cast<std::uint32_t>(dense_.size() - 1);
+        if (i != last) {
+            dense_[i] = std::move(dense_[last]);
+            entities_[i] = entities_[last];
+            versions_[i] = versions_[last];
+            ref(entities_[i]) = i;
+        }
+        dense_.pop_back();
+        entities_.pop_back();
+        versions_.pop_back();
+        ref(e) = kNull;
+    }
+
+    // Exchanges the dense slots i and j (component and owner)
+    void swapAt(std::uint32_t i, std::uint32_t j) override {
+        if (i == j) return;
+        std::swap(dense_[i], dense_[j]);
+        std::swap(entities_[i], entities_[j]);
+        std::swap(versions_[i], versions_[j]);
+        ref(entities_[i]) = i;
+        ref(entities_[j]) = j;
+    }
+
+    void save(PoolImage& out) const override {
+        const std::size_t n = dense_.size();
+        out.size = n;
+        out.make = &makeEmpty;
+        out.bytes.resize(n * kRowBytes);
+        if (n == 0) return;
+        std::memcpy(out.bytes.data(), entities_.data(), n * sizeof(Entity));
+        std::memcpy(out.bytes.data() + n * sizeof(Entity), versions_.data(), n * sizeof(std::uint32_t));
+        if constexpr (kRaw) {
+            std::memcpy(out.bytes.data() + n * (sizeof(Entity) + sizeof(std::uint32_t)), dense_.data(), n * sizeof(C));
+        } else {
+            if (!out.objects) out.objects = std::make_shared<std::vector<C>>();
+            *static_cast<std::vector<C>*>(out.objects.get()) = dense_;
+        }
+    }
+
+    void load(const PoolImage& in) override {
+        for (Entity e : entities_) ref(e) = kNull;
+        const std::size_t n = in.size;
+        entities_.resize(n);
+        versions_.resize(n);
+        if (n == 0) {
+            dense_.clear();
+            return;
+        }
+        std::memcpy(entities_.data(), in.bytes.data(), n * sizeof(Entity));
+        std::memcpy(versions_.data(), in.bytes.data() + n * sizeof(Entity), n * sizeof(std::uint32_t));
+        if constexpr (kRaw) {
+            dense_.resize(n);
+            std::memcpy(dense_.data(), in.bytes.data() + n * (sizeof(Entity) + sizeof(std::uint32_t)), n * sizeof(C));
+        } else {
+            dense_ = *static_cast<const std::vector<C>*>(in.objects.get());
+        }
+        for (std::size_t i = 0; i < n; ++i) ref(entities_[i]) = static_cast<std::uint32_t>(i);
+    }
+
+    void reserve(std::size_t n) {
+        dense_.reserve(n);
+        entities_.reserve(n);
+        versions_.reserve(n);
+    }
+
+    // Tick of the last write to e's component (0 if absent); touch() stamps
+    // writes made through raw component pointers
+    std::uint32_t version(Entity e) const {
+        auto i = slot(e);
+        return i == kNull ? 0 : versions_[i];
+    }
+    void touch(Entity e) {
+        auto i = slot(e);
+        if (i != kNull) versions_[i] = now();
+    }
+    // Stamps dense positions [first, last)
+    void touchRange(std::size_t first, std::size_t last) {
+        std::fill(versions_.begin() + first, versions_.begin() + last, now());
+    }
+
+    std::size_t size() const { return dense_.size(); }
+    std::size_t capacity() const { return dense_.capacity(); }
+    bool empty() const { return dense_.empty(); }
+
+    // Dense views: entities()[i] owns components()[i], written at versions()[i].
+    // Writes through components()/data() are not stamped (see touch()).
+    const std::vector<Entity>& entities() const { return entities_; }
+    const std::vector<std::uint32_t>& versions() const { return versions_; }
+    std::vector<C>& components() { return dense_; }
+    const std::vector<C>& components() const { return dense_; }
+
+    Pairs<C> data() { return Pairs<C>(entities_.data(), dense_.data(), dense_.size()); }
+    Pairs<const C> data() const { return Pairs<const C>(entities_.data(), dense_.data(), dense_.size()); }
+
   private:
-    std::unordered_map<Entity, C> data_;
+    using Page = std::array<std::uint32_t, kPageSize>;
+
+    // Components saved as raw bytes (memcpy) rather than copied one by one
+    static constexpr bool kRaw = std::is_trivially_copyable_v<C> && std::is_default_constructible_v<C>;
+    static constexpr std::size_t kRowBytes = sizeof(Entity) + sizeof(std::uint32_t) + (kRaw ? sizeof(C) : 0);
+
+    static std::unique_ptr<IStorage> makeEmpty(const std::uint32_t* clock) {
+        return std::make_unique<ComponentStorage>(clock);
+    }
+
+    std::uint32_t now() const { return clock_ ? *clock_ : 0; }
+
+    std::uint32_t slot(Entity e) const {
+        auto p = static_cast<std::size_t>(entityIndex(e)) / kPageSize;
+        if (p >= sparse_.size() || !sparse_[p]) return kNull;
+        auto i = (*sparse_[p])[static_cast<std::size_t>(entityIndex(e)) % kPageSize];
+        return (i != kNull && entities_[i] == e) ? i : kNull;
+    }
+
+    std::uint32_t& ref(Entity e) {
+        auto p = static_cast<std::size_t>(entityIndex(e)) / kPageSize;
+        if (p >= sparse_.size()) sparse_.resize(p + 1);
+        if (!sparse_[p]) {
+            sparse_[p] = std::make_unique<Page>();
+            sparse_[p]->fill(kNull);
+        }
+        return (*sparse_[p])[static_cast<std::size_t>(entityIndex(e)) % kPageSize];
+    }
+
+    template <typename T>
+    C& insert(Entity e, T&& c) {
+        auto& s = ref(e);
+        if (s != kNull) {
+            entities_[s] = e;
+            versions_[s] = now();
+            return dense_[s] = std::forward<T>(c);
+        }
+        s = static_cast<std::uint32_t>(dense_.size());
+        entities_.push_back(e);
+        versions_.push_back(now());
+        dense_.push_back(std::forward<T>(c));
+        return dense_.back();
+    }
+
+    std::vector<C> dense_;
+    std::vector<Entity> entities_;
+    std::vector<std::uint32_t> versions_;
+    std::vector<std::unique_ptr<Page>> sparse_;
+    const std::uint32_t* clock_;
 };
 
 }
@@ -1,4 +1,6 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include "rt/ecs/Types.hpp"
 
@@ -6,10 +8,135 @@ namespace rt::ecs {
 
 class Registry;
 
+template <typename C>
+void ensurePool(Registry& r);
+template <typename T>
+void ensureCtx(Registry& r);
+
+// Pseudo-resource for the entity slot table: create() (also through a command
+// buffer), immediate emplace()/remove() and has()/valid() go through it.
+struct EntitySlots {};
+
+// What a system touches during update(). Two systems may run side by side only
+// when neither writes something the other reads or writes. Deferred changes
+// (CommandBuffer) count as writes too: they land after the whole wave.
+struct Access {
+    Signature reads = 0;  // components, one bit per componentId
+    Signature writes = 0;
+    Signature resourceReads = 0; // resources and ctx() entries, one bit per resourceId
+    Signature resourceWrites = 0;
+    std::vector<void (*)(Registry&)> pools; // pools and ctx() entries, created before a parallel run
+
+    template <typename... Cs>
+    Access& read() {
+        ((reads |= bit<Cs>(), pools.push_back(&ensurePool<Cs>)), ...);
+        return *this;
+    }
+    template <typename... Cs>
+    Access& write() {
+        ((writes |= bit<Cs>(), pools.push_back(&ensurePool<Cs>)), ...);
+        return *this;
+    }
+
+    // State outside the registry (e.g. a shared std::mt19937): a bit, no pool
+    template <typename... Ts>
+    Access& readResource() { ((resourceReads |= resourceBit<Ts>()), ...); return *this; }
+    template <typename... Ts>
+    Access& writeResource() { ((resourceWrites |= resourceBit<Ts>()), ...); return *this; }
+
+    // Registry::ctx<T>() state: a resource whose entry plan() creates, so no
+    // system adds one to the registry while a wave runs
+    template <typename... Ts>
+    Access& readCtx() {
+        ((resourceReads |= resourceBit<Ts>(), pools.push_back(&ensureCtx<Ts>)), ...);
+        return *this;
+    }
+    template <typename... Ts>
+    Access& writeCtx() {
+        ((resourceWrites |= resourceBit<Ts>(), pools.push_back(&ensureCtx<Ts>)), ...);
+        return *this;
+    }
+
+    // Creates entities or adds/removes components immediately
+    Access& structural() { return writeResource<EntitySlots>(); }
+    // Destroys entities: may touch any pool, and onDestroy listeners any
+    // resource
+    Access& destroys() {
+        writes = resourceWrites = ~Signature{0};
+        return *this;
+    }
+
+    static Access everything() {
+        Access a;
+        a.reads = a.writes = a.resourceReads = a.resourceWrites = ~Signature{0};
+        return a;
+    }
+
+    bool conflicts(const Access& o) const {
+        return (writes & (o.reads | o.writes)) != 0 || (o.writes & reads) != 0 ||
+               (resourceWrites & (o.resourceReads | o.resourceWrites)) != 0 ||
+               (o.resourceWrites & resourceReads) != 0;
+    }
+
+  private:
+    // Ids past the signature width fall back to "everything" (conservative)
+    template <typename T>
+    static Signature bit() {
+        auto id = componentId<T>();
+        return id < kMaxComponents ? Signature{1} << id : ~Signature{0};
+    }
+    template <typename T>
+    static Signature resourceBit() {
+        auto id = resourceId<T>();
+        return id < kMaxComponents ? Signature{1} << id : ~Signature{0};
+    }
+};
+
+// How often Registry::update runs a system (see Registry::addSystem). With
+// every = 3 it runs on one tick in three and gets the dt summed since its last
+// run; with slices = 4 each run covers a quarter of its entities (slice()).
+struct Schedule {
+    std::uint32_t every = 1;
+    std::uint32_t slices = 1;
+    std::uint32_t phase = 0; // tick of `every` it runs on, to spread systems sharing a divisor
+};
+
+// Share of the entities a sliced system handles in the current run: positions
+// [begin(n), end(n)) of a pool or view driving n entities
+struct Slice {
+    std::uint32_t index = 0;
+    std::uint32_t count = 1;
+    std::size_t begin(std::size_t n) const { return n * index / count; }
+    std::size_t end(std::size_t n) const { return n * (index + 1) / count; }
+};
+
+// Registry::systemStats() entry. Timings cover update() plus the flush of the
+// system's commands, over its last kWindow runs; counters add up since the
+// last resetSystemStats().
+struct SystemStats {
+    static constexpr std::size_t kWindow = 128;
+
+    const char* name = "";
+    std::uint64_t runs = 0;
+    double p50Us = 0.0;
+    double p99Us = 0.0;
+    double maxUs = 0.0;
+    double totalUs = 0.0;
+    std::uint64_t processed = 0; // entities visited (see Registry::countProcessed)
+    std::uint64_t created = 0;
+    std::uint64_t destroyed = 0;
+};
+
 class System {
   public:
     virtual ~System() = default;
     virtual void update(Registry& registry, float dt) = 0;
+    // Label in Registry::systemStats()
+    virtual const char* name() const { return "System"; }
+    // Called once by Registry::addSystem, before any update: connect signals here
+    virtual void attach(Registry& registry) { (void)registry; }
+    // Systems that do not declare their access never share a wave
+    virtual Access access() const { return Access::everything(); }
 };
 
 }
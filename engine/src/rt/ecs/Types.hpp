@@ -1,10 +1,62 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
 
 namespace rt::ecs {
+// Entity handles pack a slot index (low bits) and a generation (high bits).
+// Destroying an entity bumps its slot generation, so a recycled index never
+// reproduces a handle that was handed out before (until the generation wraps).
 using Entity = std::uint32_t;
 static constexpr Entity kInvalidEntity = 0;
 
+static constexpr std::uint32_t kEntityIndexBits = 20;
+static constexpr std::uint32_t kEntityIndexMask = (1u << kEntityIndexBits) - 1;
+static constexpr std::uint32_t kEntityGenerationMask = (1u << (32 - kEntityIndexBits)) - 1;
+
+constexpr std::uint32_t entityIndex(Entity e) { return e & kEntityIndexMask; }
+constexpr std::uint32_t entityGeneration(Entity e) { return e >> kEntityIndexBits; }
+constexpr Entity makeEntity(std::uint32_t index, std::uint32_t generation) {
+    return (generation & kEntityGenerationMask) << kEntityIndexBits | (index & kEntityIndexMask);
+}
+
+// One bit per component id (see componentId); caps a process at 64 component types.
+using Signature = std::uint64_t;
+static constexpr std::size_t kMaxComponents = 64;
+
+namespace detail {
+// Process-wide counter behind componentId<C>(); defined in Registry.cpp so every
+// user of the engine library shares one sequence.
+std::size_t nextComponentId();
+// Same for resourceId<T>(), a sequence of its own
+std::size_t nextResourceId();
+
+// Work done on the current thread, read around every system run for
+// Registry::systemStats(): entities visited by views and groups (or reported
+// with Registry::countProcessed), entities created and destroyed
+struct WorkCounters {
+    std::uint64_t processed = 0;
+    std::uint64_t created = 0;
+    std::uint64_t destroyed = 0;
+};
+inline thread_local WorkCounters work;
+}
+
+// Dense per-type id, assigned on first use (no RTTI). It is both the index of
+// the type's pool in every registry and its signature bit.
+template <typename C>
+std::size_t componentId() {
+    static const std::size_t id = detail::nextComponentId();
+    return id;
+}
+
+// Dense per-type id for Registry::ctx() entries and Access resources. Kept
+// apart from componentId so they take neither pool slots nor signature bits.
+template <typename T>
+std::size_t resourceId() {
+    static const std::size_t id = detail::nextResourceId();
+    return id;
+}
+
 // Small, typed bits for input or flags when helpful.
 using Bits8 = std::uint8_t;
 }
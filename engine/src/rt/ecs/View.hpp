@@ -0,0 +1,107 @@
+#pragma once
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include "rt/ecs/Types.hpp"
+#include "rt/ecs/Storage.hpp"
+
+namespace rt::ecs {
+
+// Tag carrying the component types a view must NOT have: view<A, B>(exclude<C>)
+template <typename... Ts>
+struct exclude_t {};
+template <typename... Ts>
+inline constexpr exclude_t<Ts...> exclude{};
+
+// Pool type for a (possibly const-qualified) component: const C -> const storage
+template <typename C>
+using storage_for_t = std::conditional_t<std::is_const_v<C>,
+    const ComponentStorage<std::remove_const_t<C>>, ComponentStorage<C>>;
+
+template <typename Exclude, typename... Cs>
+class View;
+
+// Multi-component query over sparse-set pools. Iteration is driven by the
+// smallest included pool; every other pool is probed by index, so there is no
+// per-component type lookup or hashing in the loop. Structural changes to the
+// viewed pools while iterating are not allowed (use Registry::commands()).
+template <typename... Ex, typename... Cs>
+class View<exclude_t<Ex...>, Cs...> {
+    static_assert(sizeof...(Cs) > 0, "a view needs at least one component");
+
+  public:
+    using value_type = std::tuple<Entity, Cs&...>;
+
+    View(storage_for_t<Cs>&... pools, const ComponentStorage<Ex>&... excluded)
+        : pools_(&pools...), excluded_(&excluded...) {
+        driver_ = &std::get<0>(pools_)->entities();
+        ((pools.size() < driver_->size() ? (void)(driver_ = &pools.entities()) : (void)0), ...);
+    }
+
+    // True when `e` has every included component and none of the excluded ones
+    bool contains(Entity e) const {
+        return std::apply([e](auto*... p) { return (p->contains(e) && ...); }, pools_)
+            && std::apply([e](auto*... p) { return (!p->contains(e) && ...); }, excluded_);
+    }
+
+    // Upper bound on the number of matches (size of the driving pool)
+    std::size_t sizeHint() const { return driver_->size(); }
+
+    template <typename C>
+    decltype(auto) get(Entity e) const {
+        return *std::get<storage_for_t<C>*>(pools_)->get(e);
+    }
+
+    // fn(Entity, Cs&...) or fn(Cs&...). Entities appended to the driving pool
+    // during the walk are not visited.
+    template <typename F>
+    void each(F&& fn) const { each(0, driver_->size(), fn); }
+
+    // each() over driving-pool positions [first, last); disjoint ranges may run
+    // on different threads when fn only touches the entity it is handed
+    template <typename F>
+    void each(std::size_t first, std::size_t last, F&& fn) const {
+        std::uint64_t visited = 0;
+        for (std::size_t i = first; i < last && i < driver_->size(); ++i) {
+            const Entity e = (*driver_)[i];
+            if (!contains(e)) continue;
+            ++visited;
+            if constexpr (std::is_invocable_v<F&, Entity, Cs&...>) {
+                fn(e, *std::get<storage_for_t<Cs>*>(pools_)->get(e)...);
+            } else {
+                fn(*std::get<storage_for_t<Cs>*>(pools_)->get(e)...);
+            }
+        }
+        detail::work.processed += visited;
+    }
+
+    class iterator {
+      public:
+        iterator(const View* v, std::size_t i) : v_(v), i_(i) { skip(); }
+        value_type operator*() const {
+            const Entity e = (*v_->driver_)[i_];
+            return value_type(e, *std::get<storage_for_t<Cs>*>(v_->pools_)->get(e)...);
+        }
+        iterator& operator++() { ++i_; skip(); return *this; }
+        bool operator!=(const iterator& o) const { return i_ != o.i_; }
+        bool operator==(const iterator& o) const { return i_ == o.i_; }
+      private:
+        void skip() {
+            while (i_ < v_->driver_->size() && !v_->contains((*v_->driver_)[i_])) ++i_;
+        }
+        const View* v_;
+        std::size_t i_;
+    };
+
+    // Range-for yields tuples of references: `for (auto [e, t, v] : view)`
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, driver_->size()); }
+
+  private:
+    std::tuple<storage_for_t<Cs>*...> pools_;
+    std::tuple<const ComponentStorage<Ex>*...> excluded_;
+    const std::vector<Entity>* driver_ = nullptr;
+};
+
+}
@@ -1,34 +1,43 @@
 #pragma once
 #include "common/Protocol.hpp" // For rtype::net::EntityType
 #include "rt/ecs/Types.hpp"
+#include "rt/reflect/Reflect.hpp"
 #include <cstdint>
 #include <string>
 
 namespace rt::game {
 
+// Components sent over the network declare their fields with RT_REFLECT
+// (rt/reflect/Binary.hpp then packs them)
+
 // Basic transform and kinematics
 struct Transform {
   float x = 0.f;
   float y = 0.f;
 };
+RT_REFLECT(Transform, x, y)
 struct Velocity {
   float vx = 0.f;
   float vy = 0.f;
 };
+RT_REFLECT(Velocity, vx, vy)
 
 // Visual / net metadata (kept for server serialization compatibility)
 struct ColorRGBA {
   std::uint32_t rgba = 0xFFFFFFFFu;
 };
+RT_REFLECT(ColorRGBA, rgba)
 struct NetType {
   rtype::net::EntityType type;
 };
+RT_REFLECT(NetType, type)
 
 // Generic AABB size
 struct Size {
   float w = 0.f;
   float h = 0.f;
 };
+RT_REFLECT(Size, w, h)
 
 // Input component (server sets bits from network)
 struct PlayerInput {
@@ -77,24 +86,21 @@ struct ChargeGun {
 };
 
 struct EnemyShooter {
+  // Initial delay; once armed, what is left of it on the tick of the next shot
   float cooldown = 0.f;
   float interval = 1.0f;
   float bulletSpeed = 220.f;
   float accuracy = 0.6f;
 };
 
-struct HitFlag {
-  bool value = false;
-};
+// Countdown effects, granted with grantInvincible()/grantInfiniteFire() and
+// removed when their EffectClock wheel reaches `expires`
 struct Invincible {
-  float timeLeft = 0.f;
+  std::uint64_t expires = 0;
 };
 struct InfiniteFire {
-  float timeLeft = 0.f;
+  std::uint64_t expires = 0;
 };
-struct LifePickup {
-  bool pending = true;
-}; // Marker for server to grant extra life
 
 struct Name {
   std::string value;
@@ -102,10 +108,12 @@ struct Name {
 struct Lives {
   std::uint8_t value = 0;
 };
+RT_REFLECT(Lives, value)
 
 struct Score {
   std::int32_t value = 0;
 };
+RT_REFLECT(Score, value)
 
 enum class FormationType : std::uint8_t {
   None = 0,
@@ -140,5 +148,6 @@ enum class PowerupType : std::uint8_t {
 struct PowerupTag {
   PowerupType type = PowerupType::Life;
 };
+RT_REFLECT(PowerupTag, type)
 
 } // namespace rt::game
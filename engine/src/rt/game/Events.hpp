@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+#include <variant>
+#include "rt/ecs/EventRing.hpp"
+#include "rt/ecs/Types.hpp"
+#include "rt/game/Components.hpp"
+
+namespace rt::game {
+
+// Gameplay events, pushed by systems into registry.ctx<GameEvents>() and
+// drained by the session once per tick. `killer` / `player` credited with the
+// points is kInvalidEntity when nobody scored.
+struct PlayerHit {
+  rt::ecs::Entity player;
+  rt::ecs::Entity by; // enemy bullet, or the enemy rammed
+};
+struct EnemyKilled {
+  rt::ecs::Entity enemy;
+  rt::ecs::Entity killer;
+  std::int32_t points;
+};
+struct BossDefeated {
+  rt::ecs::Entity boss;
+  rt::ecs::Entity killer;
+  std::int32_t points;
+};
+struct PowerupTaken {
+  rt::ecs::Entity player;
+  PowerupType type;
+};
+// Any entity with a NetType leaving the world (see trackDespawns)
+struct EntityDespawned {
+  rt::ecs::Entity entity;
+  rtype::net::EntityType type;
+};
+
+using GameEvent =
+    std::variant<PlayerHit, EnemyKilled, BossDefeated, PowerupTaken, EntityDespawned>;
+using GameEvents = rt::ecs::EventRing<GameEvent>;
+
+// Visitor built from lambdas, for std::visit over a GameEvent:
+//   std::visit(Handlers{[](const PlayerHit&) {...}, [](const auto&) {}}, ev);
+template <typename... Fs>
+struct Handlers : Fs... {
+  using Fs::operator()...;
+};
+template <typename... Fs>
+Handlers(Fs...) -> Handlers<Fs...>;
+
+} // namespace rt::game
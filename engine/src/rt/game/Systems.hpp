@@ -1,43 +1,80 @@
 #pragma once
+#include <cstdint>
 #include <random>
+#include <vector>
 #include "rt/ecs/System.hpp"
 #include "rt/ecs/Registry.hpp"
 #include "rt/game/Components.hpp"
+#include "rt/game/Events.hpp"
+#include "rt/spatial/SpatialIndex.hpp"
+#include "rt/timer/TimerWheel.hpp"
 
 namespace rt::game {
 
 class InputSystem : public rt::ecs::System {
   public:
     void update(rt::ecs::Registry& r, float dt) override;
+    const char* name() const override { return "InputSystem"; }
+    rt::ecs::Access access() const override;
 };
 
 class MovementSystem : public rt::ecs::System {
   public:
     void update(rt::ecs::Registry& r, float dt) override;
+    const char* name() const override { return "MovementSystem"; }
+    rt::ecs::Access access() const override;
 };
 
 class ShootingSystem : public rt::ecs::System {
   public:
     void update(rt::ecs::Registry& r, float dt) override;
+    const char* name() const override { return "ShootingSystem"; }
+    rt::ecs::Access access() const override;
 };
 
 class ChargeShootingSystem : public rt::ecs::System {
   public:
     void update(rt::ecs::Registry& r, float dt) override;
+    const char* name() const override { return "ChargeShootingSystem"; }
+    rt::ecs::Access access() const override;
 };
 
+// Layers of the shared spatial index (Registry::ctx<rt::spatial::SpatialIndex>())
+inline constexpr rt::spatial::SpatialIndex::Layers kPlayerLayer = 1u << 0;
+inline constexpr rt::spatial::SpatialIndex::Layers kEnemyLayer = 1u << 1;
+
+// Rebuilds the shared spatial index from the players' Transform/Size. Register
+// it after movement: EnemyShootingSystem and PowerupCollisionSystem query it.
+class SpatialIndexSystem : public rt::ecs::System {
+  public:
+    void update(rt::ecs::Registry& r, float dt) override;
+    const char* name() const override { return "SpatialIndexSystem"; }
+    rt::ecs::Access access() const override;
+};
+
+// Each EnemyShooter is armed on its next shot tick in a timer wheel (ticking
+// once per run while players exist), so only shooters due to fire are visited
 class EnemyShootingSystem : public rt::ecs::System {
   public:
     explicit EnemyShootingSystem(std::mt19937& rng) : rng_(rng) {}
+    void attach(rt::ecs::Registry& r) override;
     void update(rt::ecs::Registry& r, float dt) override;
+    const char* name() const override { return "EnemyShootingSystem"; }
+    rt::ecs::Access access() const override;
   private:
+    void arm(rt::ecs::Registry& r, rt::ecs::Entity e);
     std::mt19937& rng_;
+    rt::timer::TimerWheel shots_;
+    std::vector<rt::ecs::Entity> due_;
+    float step_ = 1.f / 60.f;
 };
 
 class FormationSystem : public rt::ecs::System {
   public:
     explicit FormationSystem(float* elapsedPtr) : t_(elapsedPtr) {}
     void update(rt::ecs::Registry& r, float dt) override;
+    const char* name() const override { return "FormationSystem"; }
+    rt::ecs::Access access() const override;
   private:
     float* t_;
 };
@@ -46,6 +83,8 @@ class DespawnOffscreenSystem : public rt::ecs::System {
   public:
     explicit DespawnOffscreenSystem(float minX) : minX_(minX) {}
     void update(rt::ecs::Registry& r, float dt) override;
+    const char* name() const override { return "DespawnOffscreenSystem"; }
+    rt::ecs::Access access() const override;
   private:
     float minX_;
 };
@@ -55,13 +94,46 @@ class DespawnOutOfBoundsSystem : public rt::ecs::System {
     DespawnOutOfBoundsSystem(float minX, float maxX, float minY, float maxY)
         : minX_(minX), maxX_(maxX), minY_(minY), maxY_(maxY) {}
     void update(rt::ecs::Registry& r, float dt) override;
+    const char* name() const override { return "DespawnOutOfBoundsSystem"; }
+    rt::ecs::Access access() const override;
   private:
     float minX_, maxX_, minY_, maxY_;
 };
 
+// Expiry schedule of one countdown effect. Only the system removing that
+// effect advances the wheel, once per run; `step` is the dt it last ran with,
+// which grants use to turn seconds into ticks of that wheel.
+struct EffectClock {
+    rt::timer::TimerWheel wheel;
+    float step = 1.f / 60.f;
+};
+
+// Registry::ctx<EffectTimers>(): one clock per effect, so systems running at
+// different rates never move each other's wheel or step
+struct EffectTimers {
+    EffectClock invincible;
+    EffectClock infiniteFire;
+};
+
+// Runs of `remaining -= step` until it reaches zero or below (at least one),
+// leaving `remaining` at that last value: the tick a per-frame countdown of
+// the same float would have hit, so wheel expiries match it exactly
+std::uint64_t countdown(float& remaining, float step);
+
+// Grant `seconds` of the effect to `e`, or extend it to that; never shortens
+void grantInvincible(rt::ecs::Registry& r, rt::ecs::Entity e, float seconds);
+void grantInfiniteFire(rt::ecs::Registry& r, rt::ecs::Entity e, float seconds);
+
+// Pushes EntityDespawned into ctx<GameEvents>() whenever an entity with a
+// NetType is destroyed, inside update() or not
+void trackDespawns(rt::ecs::Registry& r);
+
+// Removes Invincible when its timer fires
 class InvincibilitySystem : public rt::ecs::System {
   public:
     void update(rt::ecs::Registry& r, float dt) override;
+    const char* name() const override { return "InvincibilitySystem"; }
+    rt::ecs::Access access() const override;
 };
 
 class FormationSpawnSystem : public rt::ecs::System {
@@ -81,6 +153,8 @@ class FormationSpawnSystem : public rt::ecs::System {
   }
   void setShooterPercent(std::uint8_t percent) { shooterPercent_ = percent; }
     void update(rt::ecs::Registry& r, float dt) override;
+    const char* name() const override { return "FormationSpawnSystem"; }
+    rt::ecs::Access access() const override;
   private:
     std::mt19937& rng_;
     float timer_ = 0.f;
@@ -105,6 +179,8 @@ class PowerupSpawnSystem : public rt::ecs::System {
     PowerupSpawnSystem(std::mt19937& rng, std::int32_t* teamScorePtr)
       : rng_(rng), teamScore_(teamScorePtr) {}
     void update(rt::ecs::Registry& r, float dt) override;
+    const char* name() const override { return "PowerupSpawnSystem"; }
+    rt::ecs::Access access() const override;
   private:
     std::mt19937& rng_;
     std::int32_t* teamScore_;
@@ -117,16 +193,32 @@ class PowerupSpawnSystem : public rt::ecs::System {
 class PowerupCollisionSystem : public rt::ecs::System {
   public:
     void update(rt::ecs::Registry& r, float dt) override;
+    const char* name() const override { return "PowerupCollisionSystem"; }
+    rt::ecs::Access access() const override;
 };
 
+// Keeps shooters of InfiniteFire holders ready; removes the effect when its timer fires
 class InfiniteFireSystem : public rt::ecs::System {
   public:
     void update(rt::ecs::Registry& r, float dt) override;
+    const char* name() const override { return "InfiniteFireSystem"; }
+    rt::ecs::Access access() const override;
 };
 
 class CollisionSystem : public rt::ecs::System {
   public:
     void update(rt::ecs::Registry& r, float dt) override;
+    const char* name() const override { return "CollisionSystem"; }
+    rt::ecs::Access access() const override;
+  private:
+    struct Box { rt::ecs::Entity e; float x, y, x2, y2; };
+    struct Shot { Box box; BulletFaction faction; std::uint32_t first; };
+
+    rt::spatial::SpatialIndex enemies_; // tick snapshot; index == enemy order
+    // Per-tick scratch, cleared rather than freed
+    std::vector<Box> players_;
+    std::vector<Shot> shots_;
+    std::vector<std::uint32_t> hits_;
 };
 
 // Spawns the boss every time any player's score crosses a multiple of `threshold_`; prevents other spawns while active
@@ -134,6 +226,8 @@ class BossSpawnSystem : public rt::ecs::System {
   public:
     explicit BossSpawnSystem(int threshold = 15000) : threshold_(threshold) {}
     void update(rt::ecs::Registry& r, float dt) override;
+    const char* name() const override { return "BossSpawnSystem"; }
+    rt::ecs::Access access() const override;
   private:
     int threshold_ = 15000;
     // Number of bosses spawned so far (for threshold multiples)
@@ -146,6 +240,8 @@ class BossSpawnSystem : public rt::ecs::System {
 class BossSystem : public rt::ecs::System {
   public:
     void update(rt::ecs::Registry& r, float dt) override;
+    const char* name() const override { return "BossSystem"; }
+    rt::ecs::Access access() const override;
 };
 
 }
@@ -0,0 +1,68 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace rt::jobs {
+
+// FIFO between pipeline stages with a fixed number of places: push() waits
+// while it is full, which is how a slow consumer holds back its producer, and
+// pop() waits while it is empty. close() wakes both sides; pop() still hands
+// out what was queued before returning false. Storage is allocated once, so T
+// must be default constructible and movable.
+template <typename T>
+class BoundedQueue {
+  public:
+    explicit BoundedQueue(std::size_t capacity) : items_(capacity ? capacity : 1) {}
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    std::size_t capacity() const { return items_.size(); }
+
+    // False, leaving v alone, once the queue is closed
+    bool push(T&& v) {
+        std::unique_lock<std::mutex> lock(m_);
+        notFull_.wait(lock, [&] { return closed_ || size_ < items_.size(); });
+        if (closed_) return false;
+        items_[(head_ + size_) % items_.size()] = std::move(v);
+        ++size_;
+        lock.unlock();
+        notEmpty_.notify_one();
+        return true;
+    }
+
+    // False once the queue is closed and empty
+    bool pop(T& out) {
+        std::unique_lock<std::mutex> lock(m_);
+        notEmpty_.wait(lock, [&] { return closed_ || size_ > 0; });
+        if (size_ == 0) return false;
+        out = std::move(items_[head_]);
+        items_[head_] = T{};
+        head_ = (head_ + 1) % items_.size();
+        --size_;
+        lock.unlock();
+        notFull_.notify_one();
+        return true;
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(m_);
+            closed_ = true;
+        }
+        notFull_.notify_all();
+        notEmpty_.notify_all();
+    }
+
+  private:
+    std::mutex m_;
+    std::condition_variable notFull_, notEmpty_;
+    std::vector<T> items_;
+    std::size_t head_ = 0;
+    std::size_t size_ = 0;
+    bool closed_ = false;
+};
+
+}
@@ -0,0 +1,114 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "rt/ecs/Types.hpp"
+
+namespace rt::jobs {
+
+// Work-stealing pool. Every worker owns a deque: it pops its own work from the
+// back and steals from the front of the others when idle. A thread waiting in
+// run()/parallelFor() executes queued tasks instead of blocking, so nested
+// calls from inside a task are fine and a pool with 0 workers runs everything
+// inline, in order. The first exception thrown by a task is rethrown to the
+// waiting caller.
+class JobSystem {
+  public:
+    using Task = std::function<void()>;
+    using RangeFn = std::function<void(std::size_t begin, std::size_t end)>;
+
+    static constexpr std::size_t kDefaultChunk = 256;
+
+    explicit JobSystem(std::size_t workers = defaultWorkers(), std::size_t chunk = defaultChunk());
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    std::size_t workerCount() const { return threads_.size(); }
+
+    // Indices per task used by parallelFor() when called with chunk == 0
+    std::size_t chunkSize() const { return chunk_; }
+    void setChunkSize(std::size_t chunk) { chunk_ = chunk ? chunk : 1; }
+
+    void run(const std::vector<Task>& tasks);
+
+    // fn(begin, end) over [0, count) split into chunks of `chunk` indices
+    // (0: chunkSize()). Single-chunk ranges run inline on the caller. fn is
+    // called through a plain function pointer, not wrapped in a std::function, so
+    // the inline path does not allocate.
+    template <typename F>
+    void parallelFor(std::size_t count, std::size_t chunk, const F& fn) {
+        parallelFor(count, chunk, &fn, [](const void* ctx, std::size_t begin, std::size_t end) {
+            (*static_cast<const F*>(ctx))(begin, end);
+        });
+    }
+
+    // RTYPE_JOB_WORKERS if set, else one less than the hardware threads
+    static std::size_t defaultWorkers();
+    // RTYPE_JOB_CHUNK if set, else kDefaultChunk
+    static std::size_t defaultChunk();
+
+  private:
+    struct Batch {
+        std::atomic<std::size_t> pending{0};
+        std::mutex m;
+        std::exception_ptr error;
+    };
+    struct Item {
+        void (*call)(const void* ctx, std::size_t begin, std::size_t end);
+        const void* ctx;
+        std::size_t begin, end;
+        Batch* batch;
+    };
+    struct Queue {
+        std::mutex m;
+        std::deque<Item> items;
+    };
+
+    void parallelFor(std::size_t count, std::size_t chunk, const void* ctx,
+                     void (*call)(const void* ctx, std::size_t begin, std::size_t end));
+    void submit(const std::vector<Item>& items, Batch& batch);
+    bool take(std::size_t self, Item& out);
+    void execute(const Item& item);
+    void workerLoop(std::size_t index);
+
+    std::vector<std::unique_ptr<Queue>> queues_; // one per worker
+    std::vector<std::thread> threads_;
+    std::atomic<std::size_t> queued_{0};
+    std::atomic<std::size_t> next_{0}; // round-robin target for external submits
+    std::mutex sleepM_;
+    std::condition_variable wake_;
+    std::atomic<bool> stop_{false};
+    std::size_t chunk_;
+};
+
+// view.each(fn) with the driving pool split into chunks run across `jobs`
+// (plain each() when jobs is null). fn may only write the components of the
+// entity it is handed; structural changes and commands() are not allowed in
+// the body, record them afterwards from the system thread.
+template <typename View, typename F>
+void parallel_for(JobSystem* jobs, const View& view, std::size_t chunk, F&& fn) {
+    if (!jobs) {
+        view.each(fn);
+        return;
+    }
+    // Chunks count their visits on whichever thread runs them; the total is
+    // credited to the calling thread, where the system's stats are read
+    std::atomic<std::uint64_t> processed{0};
+    jobs->parallelFor(view.sizeHint(), chunk, [&](std::size_t b, std::size_t e) {
+        const auto before = rt::ecs::detail::work.processed;
+        view.each(b, e, fn);
+        processed.fetch_add(rt::ecs::detail::work.processed - before, std::memory_order_relaxed);
+        rt::ecs::detail::work.processed = before;
+    });
+    rt::ecs::detail::work.processed += processed.load(std::memory_order_relaxed);
+}
+
+}
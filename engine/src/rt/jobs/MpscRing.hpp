@@ -0,0 +1,89 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace rt::jobs {
+
+// Bounded lock-free queue for any number of producer threads and one
+// consumer. Every cell carries a sequence number that says whose turn it is:
+// producers claim a slot with one CAS on the tail and publish it by bumping
+// the cell's sequence, the consumer reads cells in order without atomics on
+// the head. tryPush() never blocks or allocates and fails when the ring is
+// full; capacity is rounded up to a power of two. T must be default
+// constructible and copy assignable.
+template <typename T>
+class MpscRing {
+  public:
+    explicit MpscRing(std::size_t capacity = 1024) {
+        std::size_t n = 2;
+        while (n < capacity) n *= 2;
+        mask_ = n - 1;
+        cells_ = std::make_unique<Cell[]>(n);
+        for (std::size_t i = 0; i < n; ++i) cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    std::size_t capacity() const { return mask_ + 1; }
+
+    // Any thread. False when the consumer is a full ring behind.
+    bool tryPush(const T& v) {
+        std::size_t pos = tail_.load(std::memory_order_relaxed);
+        Cell* c;
+        while (true) {
+            c = &cells_[pos & mask_];
+            const std::size_t seq = c->seq.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false; // the cell still holds a value from a lap ago
+            } else {
+                pos = tail_.load(std::memory_order_relaxed); // another producer took it
+            }
+        }
+        c->value = v;
+        c->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer thread only
+    bool tryPop(T& out) {
+        Cell& c = cells_[head_ & mask_];
+        if (c.seq.load(std::memory_order_acquire) != head_ + 1) return false;
+        out = std::move(c.value);
+        c.seq.store(head_ + mask_ + 1, std::memory_order_release);
+        ++head_;
+        return true;
+    }
+
+    // Consumer thread only. Calls fn(T&) on the published values, oldest
+    // first, at most one ring's worth so busy producers cannot keep it going;
+    // returns how many it handed out.
+    template <typename F>
+    std::size_t drain(F&& fn) {
+        T v;
+        std::size_t n = 0;
+        while (n <= mask_ && tryPop(v)) {
+            fn(v);
+            ++n;
+        }
+        return n;
+    }
+
+  private:
+    struct Cell {
+        std::atomic<std::size_t> seq{0};
+        T value{};
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    std::size_t mask_ = 0;
+    alignas(64) std::atomic<std::size_t> tail_{0}; // producers
+    alignas(64) std::size_t head_ = 0;             // consumer
+};
+
+}
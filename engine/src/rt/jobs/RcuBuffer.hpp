@@ -0,0 +1,106 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace rt::jobs {
+
+// Latest-value publication from one writer thread to any number of readers,
+// RCU style: the writer fills a slot nobody reads, then swaps it in with one
+// atomic store; readers pin the published slot with a reference count and
+// never wait. A slot is rewritten only once its readers are gone and it is no
+// longer the published one. Slots keep their contents between writes, so a
+// T made of containers stops allocating once every slot has seen the largest
+// value. Slots >= 2 + readers holding a value at the same time lets the writer
+// always find a slot.
+template <typename T, std::size_t Slots = 4>
+class RcuBuffer {
+    static_assert(Slots >= 2, "the writer needs a slot besides the published one");
+
+    struct Slot {
+        T value{};
+        std::atomic<std::uint32_t> refs{0};
+    };
+
+  public:
+    // Pins one published value; empty before the first publish()
+    class Reader {
+      public:
+        Reader() = default;
+        Reader(Reader&& o) noexcept : slot_(o.slot_) { o.slot_ = nullptr; }
+        Reader& operator=(Reader&& o) noexcept {
+            if (this != &o) {
+                release();
+                slot_ = o.slot_;
+                o.slot_ = nullptr;
+            }
+            return *this;
+        }
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+        ~Reader() { release(); }
+
+        explicit operator bool() const { return slot_ != nullptr; }
+        const T& operator*() const { return slot_->value; }
+        const T* operator->() const { return &slot_->value; }
+
+      private:
+        friend class RcuBuffer;
+        explicit Reader(Slot* s) : slot_(s) {}
+        void release() {
+            if (slot_) slot_->refs.fetch_sub(1, std::memory_order_release);
+            slot_ = nullptr;
+        }
+        Slot* slot_ = nullptr;
+    };
+
+    // Writer thread only. A slot to fill for the next publish(), still holding
+    // what was last written into it; null when readers pin every other slot.
+    T* beginWrite() {
+        const int cur = current_.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < Slots; ++i) {
+            if (static_cast<int>(i) == cur) continue;
+            // seq_cst, paired with read(): a reader that pins this slot from
+            // now on sees that it is not the published one and backs off
+            if (slots_[i].refs.load() == 0) {
+                writing_ = static_cast<int>(i);
+                return &slots_[i].value;
+            }
+        }
+        writing_ = -1;
+        return nullptr;
+    }
+
+    // Writer thread only. Makes the slot from beginWrite() the latest value.
+    void publish() {
+        if (writing_ < 0) return;
+        current_.store(writing_);
+        writing_ = -1;
+        published_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Any thread. The latest published value, held until the Reader goes.
+    Reader read() {
+        while (true) {
+            const int i = current_.load();
+            if (i < 0) return {};
+            Slot& s = slots_[static_cast<std::size_t>(i)];
+            s.refs.fetch_add(1);
+            if (current_.load() == i) return Reader(&s);
+            // Republished meanwhile: the slot may be getting rewritten
+            s.refs.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    // publish() calls so far
+    std::uint64_t published() const { return published_.load(std::memory_order_relaxed); }
+
+  private:
+    std::array<Slot, Slots> slots_;
+    std::atomic<int> current_{-1};
+    std::atomic<std::uint64_t> published_{0};
+    int writing_ = -1; // writer thread only
+};
+
+}
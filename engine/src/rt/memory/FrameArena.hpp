@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+namespace rt::memory {
+
+// Monotonic memory for data that lives one tick: allocations bump a pointer
+// through one block, deallocation is a no-op and reset() rewinds everything at
+// once. A frame that outgrows the block spills into extra blocks; the next
+// reset() frees them and regrows the block to the frame's peak, so once the
+// arena has seen its busiest tick it stops touching the upstream resource.
+// Not thread-safe: one arena per thread that uses it.
+class FrameArena final : public std::pmr::memory_resource {
+  public:
+    explicit FrameArena(std::size_t capacity = 64 * 1024,
+                        std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+    ~FrameArena() override;
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // Invalidates everything allocated since the last reset()
+    void reset();
+
+    std::size_t used() const { return used_; }          // bytes handed out this frame, padding included
+    std::size_t capacity() const { return capacity_; }  // size of the main block
+    std::size_t peak() const { return peak_; }          // largest used() seen at a reset()
+    std::uint64_t upstreamAllocations() const { return upstreamAllocations_; }
+
+  private:
+    struct Spill {
+        Spill* next;
+        std::size_t bytes; // header included
+        std::size_t align;
+    };
+
+    void* do_allocate(std::size_t bytes, std::size_t align) override;
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    void* spill(std::size_t bytes, std::size_t align);
+    void releaseSpills();
+
+    std::pmr::memory_resource* upstream_;
+    std::byte* block_ = nullptr;
+    std::size_t capacity_ = 0;
+    std::size_t offset_ = 0;
+    Spill* spills_ = nullptr; // blocks taken this frame after the main one filled up
+    std::size_t used_ = 0;
+    std::size_t peak_ = 0;
+    std::uint64_t upstreamAllocations_ = 0;
+};
+
+}
@@ -0,0 +1,127 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "rt/reflect/Reflect.hpp"
+
+namespace rt::reflect {
+
+// Binary encoding generated from the field lists: fields back to back, no
+// padding, host byte order (little-endian, like the rest of the protocol).
+// Plain scalars (ids, enums) can be mixed in: write(out, id, transform, ...).
+
+template <typename T>
+concept Scalar = std::is_arithmetic_v<T> || std::is_enum_v<T>;
+
+template <typename T>
+constexpr std::size_t wireSize() {
+    if constexpr (Scalar<T>) {
+        return sizeof(T);
+    } else {
+        using Fields = decltype(fields<T>());
+        return []<std::size_t... I>(std::index_sequence<I...>) {
+            return (std::size_t{0} + ... + std::tuple_element_t<I, Fields>::wireSize);
+        }(std::make_index_sequence<std::tuple_size_v<Fields>>{});
+    }
+}
+
+// Bytes of write(out, Ts...)
+template <typename... Ts>
+inline constexpr std::size_t wireSizeOf = (wireSize<Ts>() + ...);
+
+template <typename T>
+std::byte* write(std::byte* out, const T& v) {
+    if constexpr (Scalar<T>) {
+        std::memcpy(out, &v, sizeof(T));
+        return out + sizeof(T);
+    } else {
+        forEachField<T>([&](const auto& f) {
+            f.encode(out, v);
+            out += f.wireSize;
+        });
+        return out;
+    }
+}
+
+template <typename T, typename... Ts>
+    requires(sizeof...(Ts) > 0)
+std::byte* write(std::byte* out, const T& v, const Ts&... rest) {
+    return write(write(out, v), rest...);
+}
+
+template <typename T>
+const std::byte* read(const std::byte* in, T& v) {
+    if constexpr (Scalar<T>) {
+        std::memcpy(&v, in, sizeof(T));
+        return in + sizeof(T);
+    } else {
+        forEachField<T>([&](const auto& f) {
+            f.decode(in, v);
+            in += f.wireSize;
+        });
+        return in;
+    }
+}
+
+template <typename T, typename... Ts>
+    requires(sizeof...(Ts) > 0)
+const std::byte* read(const std::byte* in, T& v, Ts&... rest) {
+    return read(read(in, v), rest...);
+}
+
+// Bit i set when field i of `now` encodes differently from `before`
+template <Reflected T>
+std::uint32_t diff(const T& before, const T& now) {
+    static_assert(fieldCount<T> <= 32, "diff masks hold 32 fields");
+    std::uint32_t mask = 0;
+    std::uint32_t bit = 1;
+    forEachField<T>([&](const auto& f) {
+        if (!f.same(before, now)) mask |= bit;
+        bit <<= 1;
+    });
+    return mask;
+}
+
+// Only the fields in `mask` (from diff()); the reader needs the same mask
+template <Reflected T>
+std::byte* writeDelta(std::byte* out, const T& v, std::uint32_t mask) {
+    std::uint32_t bit = 1;
+    forEachField<T>([&](const auto& f) {
+        if (mask & bit) {
+            f.encode(out, v);
+            out += f.wireSize;
+        }
+        bit <<= 1;
+    });
+    return out;
+}
+
+template <Reflected T>
+const std::byte* readDelta(const std::byte* in, T& v, std::uint32_t mask) {
+    std::uint32_t bit = 1;
+    forEachField<T>([&](const auto& f) {
+        if (mask & bit) {
+            f.decode(in, v);
+            in += f.wireSize;
+        }
+        bit <<= 1;
+    });
+    return in;
+}
+
+// Bytes writeDelta() produces for `mask`
+template <Reflected T>
+constexpr std::size_t deltaSize(std::uint32_t mask) {
+    std::size_t n = 0;
+    std::uint32_t bit = 1;
+    forEachField<T>([&](const auto& f) {
+        if (mask & bit) n += std::decay_t<decltype(f)>::wireSize;
+        bit <<= 1;
+    });
+    return n;
+}
+
+}
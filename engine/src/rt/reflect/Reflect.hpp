@@ -0,0 +1,111 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+
+namespace rt::reflect {
+
+// Compile-time field lists. A type is reflected by an rtReflect(Tag<T>)
+// overload in its own namespace (found by ADL), returning a tuple of field
+// descriptors in wire order; RT_REFLECT(T, a, b, ...) writes it for plain
+// fields. Everything built on top (Binary.hpp) expands over that tuple, so
+// there is no runtime lookup or virtual dispatch.
+template <typename T>
+struct Tag {};
+
+// Member sent as is
+template <typename C, typename M>
+struct Field {
+    static_assert(std::is_trivially_copyable_v<M>, "reflected fields are copied bytewise");
+    using Owner = C;
+    using Type = M;
+    static constexpr std::size_t wireSize = sizeof(M);
+
+    const char* name;
+    M C::*member;
+
+    void encode(std::byte* out, const C& c) const { std::memcpy(out, &(c.*member), sizeof(M)); }
+    void decode(const std::byte* in, C& c) const { std::memcpy(&(c.*member), in, sizeof(M)); }
+    bool same(const C& a, const C& b) const { return a.*member == b.*member; }
+};
+
+// Arithmetic member sent as fixed point: round(value * Scale) in Int,
+// clamped to Int's range. Changes below 1/Scale do not count as changes.
+template <typename C, typename M, typename Int, int Scale>
+struct QuantizedField {
+    static_assert(std::is_arithmetic_v<M> && std::is_integral_v<Int> && Scale > 0);
+    using Owner = C;
+    using Type = M;
+    static constexpr std::size_t wireSize = sizeof(Int);
+
+    const char* name;
+    M C::*member;
+
+    static Int quantize(M v) {
+        const double q = std::nearbyint(static_cast<double>(v) * Scale);
+        return static_cast<Int>(std::clamp(q, static_cast<double>(std::numeric_limits<Int>::min()),
+                                           static_cast<double>(std::numeric_limits<Int>::max())));
+    }
+    static M dequantize(Int q) { return static_cast<M>(static_cast<double>(q) / Scale); }
+
+    void encode(std::byte* out, const C& c) const {
+        const Int q = quantize(c.*member);
+        std::memcpy(out, &q, sizeof(Int));
+    }
+    void decode(const std::byte* in, C& c) const {
+        Int q;
+        std::memcpy(&q, in, sizeof(Int));
+        c.*member = dequantize(q);
+    }
+    bool same(const C& a, const C& b) const { return quantize(a.*member) == quantize(b.*member); }
+};
+
+template <typename C, typename M>
+constexpr Field<C, M> field(const char* name, M C::*member) { return {name, member}; }
+
+// quantized<std::int16_t, 16>("vx", &Velocity::vx): 1/16 resolution
+template <typename Int, int Scale, typename C, typename M>
+constexpr QuantizedField<C, M, Int, Scale> quantized(const char* name, M C::*member) { return {name, member}; }
+
+template <typename T>
+concept Reflected = requires { rtReflect(Tag<T>{}); };
+
+// Descriptor tuple of T
+template <Reflected T>
+constexpr auto fields() { return rtReflect(Tag<T>{}); }
+
+template <Reflected T>
+inline constexpr std::size_t fieldCount = std::tuple_size_v<decltype(fields<T>())>;
+
+// fn(descriptor) for every field of T, in order
+template <Reflected T, typename F>
+constexpr void forEachField(F&& fn) {
+    std::apply([&](const auto&... f) { (fn(f), ...); }, fields<T>());
+}
+
+}
+
+// RT_REFLECT(Transform, x, y): fields of a struct, in wire order (up to 8).
+// Use it next to the struct, in the same namespace.
+#define RT_REFLECT(Type, ...)                                                                   \
+    [[maybe_unused]] constexpr auto rtReflect(::rt::reflect::Tag<Type>) {                        \
+        return std::make_tuple(RT_REFLECT_EXPAND(RT_REFLECT_PICK(__VA_ARGS__, RT_REFLECT_8,     \
+            RT_REFLECT_7, RT_REFLECT_6, RT_REFLECT_5, RT_REFLECT_4, RT_REFLECT_3, RT_REFLECT_2, \
+            RT_REFLECT_1)(Type, __VA_ARGS__)));                                                  \
+    }
+
+#define RT_REFLECT_EXPAND(x) x
+#define RT_REFLECT_PICK(_1, _2, _3, _4, _5, _6, _7, _8, N, ...) N
+#define RT_REFLECT_FIELD(T, m) ::rt::reflect::field(#m, &T::m)
+#define RT_REFLECT_1(T, a) RT_REFLECT_FIELD(T, a)
+#define RT_REFLECT_2(T, a, ...) RT_REFLECT_FIELD(T, a), RT_REFLECT_EXPAND(RT_REFLECT_1(T, __VA_ARGS__))
+#define RT_REFLECT_3(T, a, ...) RT_REFLECT_FIELD(T, a), RT_REFLECT_EXPAND(RT_REFLECT_2(T, __VA_ARGS__))
+#define RT_REFLECT_4(T, a, ...) RT_REFLECT_FIELD(T, a), RT_REFLECT_EXPAND(RT_REFLECT_3(T, __VA_ARGS__))
+#define RT_REFLECT_5(T, a, ...) RT_REFLECT_FIELD(T, a), RT_REFLECT_EXPAND(RT_REFLECT_4(T, __VA_ARGS__))
+#define RT_REFLECT_6(T, a, ...) RT_REFLECT_FIELD(T, a), RT_REFLECT_EXPAND(RT_REFLECT_5(T, __VA_ARGS__))
+#define RT_REFLECT_7(T, a, ...) RT_REFLECT_FIELD(T, a), RT_REFLECT_EXPAND(RT_REFLECT_6(T, __VA_ARGS__))
+#define RT_REFLECT_8(T, a, ...) RT_REFLECT_FIELD(T, a), RT_REFLECT_EXPAND(RT_REFLECT_7(T, __VA_ARGS__))
@@ -0,0 +1,15 @@
+#pragma once
+#include <cstddef>
+
+namespace rt::simd {
+
+// out[i] += in[i] * k for i in [0, n). The vector paths (AVX, SSE2 or NEON,
+// picked at compile time) do a multiply then an add per lane like the scalar
+// loop, so every path gives the same results.
+void axpy(float* out, const float* in, float k, std::size_t n);
+void axpyScalar(float* out, const float* in, float k, std::size_t n);
+
+// Vector path axpy() was built with: "avx", "sse2", "neon" or "scalar"
+const char* kernelName();
+
+}
@@ -0,0 +1,119 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "rt/ecs/Types.hpp"
+#include "rt/spatial/UniformGrid.hpp"
+
+namespace rt::spatial {
+
+// Entities bucketed in a UniformGrid and tagged with caller-defined layer bits
+// (players, enemies, ...). Rebuilt once per tick: clear(), insert(), build().
+// Queries are const (safe from several threads), never allocate and hand
+// results to a sink together with the insertion index, so callers that need a
+// deterministic order can rely on it.
+class SpatialIndex {
+  public:
+    using Layers = std::uint32_t;
+    static constexpr Layers kAllLayers = ~Layers{0};
+    static constexpr std::uint32_t kNone = ~std::uint32_t{0};
+
+    struct Item {
+        rt::ecs::Entity entity;
+        Aabb box;
+        Layers layers;
+    };
+
+    explicit SpatialIndex(float cellSize = 64.f) : grid_(cellSize) {}
+
+    void clear() {
+        grid_.clear();
+        items_.clear();
+    }
+
+    std::uint32_t insert(rt::ecs::Entity e, const Aabb& box, Layers layers) {
+        items_.push_back({e, box, layers});
+        return grid_.insert(box);
+    }
+
+    void build() { grid_.build(); }
+
+    std::size_t size() const { return items_.size(); }
+    const Item& item(std::uint32_t index) const { return items_[index]; }
+
+    // sink(index, item) for every item of `layers` overlapping `area`, once
+    // each, in no particular order
+    template <typename Sink>
+    void queryAABB(const Aabb& area, Layers layers, Sink&& sink) const {
+        grid_.forEach(area, [&](std::uint32_t i) {
+            const auto& it = items_[i];
+            if ((it.layers & layers) && overlaps(it.box, area)) sink(i, it);
+        });
+    }
+
+    // sink(index, item) for every item of `layers` whose box comes within
+    // `radius` of (x, y)
+    template <typename Sink>
+    void queryRadius(float x, float y, float radius, Layers layers, Sink&& sink) const {
+        const float r2 = radius * radius;
+        queryAABB({x - radius, y - radius, x + radius, y + radius}, layers,
+                  [&](std::uint32_t i, const Item& it) {
+                      const float dx = x < it.box.x ? it.box.x - x : (x > it.box.x2 ? x - it.box.x2 : 0.f);
+                      const float dy = y < it.box.y ? it.box.y - y : (y > it.box.y2 ? y - it.box.y2 : 0.f);
+                      if (dx * dx + dy * dy <= r2) sink(i, it);
+                  });
+    }
+
+    // Lowest insertion index of `layers` overlapping `area` and accepted by
+    // pred(index, item), or kNone: the first hit of a scan in insertion order
+    template <typename Pred>
+    std::uint32_t first(const Aabb& area, Layers layers, Pred&& pred) const {
+        std::uint32_t best = kNone;
+        queryAABB(area, layers, [&](std::uint32_t i, const Item& it) {
+            if (i < best && pred(i, it)) best = i;
+        });
+        return best;
+    }
+    std::uint32_t first(const Aabb& area, Layers layers) const {
+        return first(area, layers, [](std::uint32_t, const Item&) { return true; });
+    }
+
+    // Item of `layers` accepted by filter(index, item) whose position (box
+    // origin) is closest to (x, y), or kNone. Ties go to the lowest insertion
+    // index. Searches growing squares, so near hits never scan the whole grid.
+    template <typename Filter>
+    std::uint32_t nearest(float x, float y, Layers layers, Filter&& filter) const {
+        if (items_.empty()) return kNone;
+        std::uint32_t best = kNone;
+        float bestD2 = std::numeric_limits<float>::infinity();
+        auto visit = [&](std::uint32_t i, const Item& it) {
+            const float dx = it.box.x - x;
+            const float dy = it.box.y - y;
+            const float d2 = dx * dx + dy * dy;
+            if ((d2 < bestD2 || (d2 == bestD2 && i < best)) && filter(i, it)) {
+                bestD2 = d2;
+                best = i;
+            }
+        };
+        float radius = grid_.cellWidth() > grid_.cellHeight() ? grid_.cellWidth() : grid_.cellHeight();
+        for (int pass = 0; pass < 32; ++pass) {
+            queryAABB({x - radius, y - radius, x + radius, y + radius}, layers, visit);
+            // A hit inside the square is final once no unseen point can be closer
+            if (best != kNone && bestD2 <= radius * radius) return best;
+            radius *= 2.f;
+        }
+        for (std::uint32_t i = 0; i < items_.size(); ++i)
+            if (items_[i].layers & layers) visit(i, items_[i]);
+        return best;
+    }
+    std::uint32_t nearest(float x, float y, Layers layers) const {
+        return nearest(x, y, layers, [](std::uint32_t, const Item&) { return true; });
+    }
+
+  private:
+    UniformGrid grid_;
+    std::vector<Item> items_;
+};
+
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace rt::spatial {
+
+struct Aabb {
+    float x, y, x2, y2;
+};
+
+// Inclusive test: boxes that touch count as overlapping
+inline bool overlaps(const Aabb& a, const Aabb& b) {
+    return !(a.x2 < b.x || b.x2 < a.x || a.y2 < b.y || b.y2 < a.y);
+}
+
+// Uniform grid broadphase over axis-aligned boxes, rebuilt from scratch every
+// tick: clear(), insert() each box, build(), then query() from any number of
+// threads. Bounds follow the inserted boxes; the cell size grows when a box
+// far away would push a side past maxCellsPerAxis cells.
+class UniformGrid {
+  public:
+    explicit UniformGrid(float cellSize = 64.f, std::size_t maxCellsPerAxis = 128)
+        : cellSize_(cellSize), maxCells_(maxCellsPerAxis) {}
+
+    void clear();
+
+    // Returns the item index (insertion order)
+    std::uint32_t insert(const Aabb& box);
+
+    // Buckets the inserted boxes per cell (items ascending inside a cell)
+    void build();
+
+    std::size_t size() const { return boxes_.size(); }
+    const Aabb& box(std::uint32_t item) const { return boxes_[item]; }
+
+    // Replaces `out` with the items sharing a cell with `area`, ascending and
+    // without duplicates. Candidates only: the caller runs the exact test.
+    void query(const Aabb& area, std::vector<std::uint32_t>& out) const;
+
+    // fn(item) once for every item sharing a cell with `area`, in no particular
+    // order and without allocating: an item spanning several cells is only
+    // reported from the first cell it shares with the area. Candidates only.
+    template <typename F>
+    void forEach(const Aabb& area, F&& fn) const {
+        if (cols_ == 0) return;
+        const auto q = cells(area);
+        for (auto y = q.r0; y <= q.r1; ++y)
+            for (auto x = q.c0; x <= q.c1; ++x) {
+                const auto cell = y * cols_ + x;
+                for (auto k = cellStart_[cell]; k < cellStart_[cell + 1]; ++k) {
+                    const auto item = items_[k];
+                    const auto r = cells(boxes_[item]);
+                    if (x == (r.c0 > q.c0 ? r.c0 : q.c0) && y == (r.r0 > q.r0 ? r.r0 : q.r0)) fn(item);
+                }
+            }
+    }
+
+    // Side of a cell as laid out by the last build() (0 before any build)
+    float cellWidth() const { return invCellW_ > 0.f ? 1.f / invCellW_ : 0.f; }
+    float cellHeight() const { return invCellH_ > 0.f ? 1.f / invCellH_ : 0.f; }
+
+  private:
+    struct CellRange {
+        std::size_t c0, r0, c1, r1;
+    };
+    CellRange cells(const Aabb& b) const;
+
+    float cellSize_;
+    std::size_t maxCells_;
+    float minX_ = 0.f, minY_ = 0.f;
+    float invCellW_ = 0.f, invCellH_ = 0.f;
+    std::size_t cols_ = 0, rows_ = 0;
+    std::vector<Aabb> boxes_;
+    std::vector<std::uint32_t> cellStart_; // rows_ * cols_ + 1 offsets into items_
+    std::vector<std::uint32_t> items_;
+    std::vector<std::uint32_t> fill_; // build() scratch
+};
+
+}
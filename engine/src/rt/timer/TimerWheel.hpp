@@ -0,0 +1,96 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "rt/ecs/Types.hpp"
+
+namespace rt::timer {
+
+// Hierarchical timing wheel keyed on an integer tick. Level l has 64 slots of
+// 64^l ticks each; a timer sits in the level of the highest 6-bit digit where
+// its due tick differs from now() and moves down a level when the clock
+// reaches its slot, so advance() only touches timers that are due (plus one
+// cascade per 64 ticks). Timers beyond the top level wait in an overflow list.
+// Timers due on the same tick fire in the order they were scheduled.
+class TimerWheel {
+  public:
+    using Id = std::uint64_t; // node index and generation; 0 is never handed out
+    static constexpr Id kNone = 0;
+
+    std::uint64_t now() const { return now_; }
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    // Fires on the advance() that brings the clock to `due`; a due tick at or
+    // before now() fires on the next advance()
+    Id schedule(std::uint64_t due, rt::ecs::Entity e, std::uint32_t tag = 0);
+    Id scheduleIn(std::uint64_t ticks, rt::ecs::Entity e, std::uint32_t tag = 0) {
+        return schedule(now_ + ticks, e, tag);
+    }
+
+    // False when the timer already fired or was cancelled. Safe to call from
+    // an advance() callback, also on timers due on the same tick.
+    bool cancel(Id id);
+
+    // Moves the clock one tick forward and calls fn(Entity, tag) for every
+    // timer due then. fn may schedule and cancel timers.
+    template <typename F>
+    void advance(F&& fn) {
+        firing_ = tick();
+        while (firing_ != kNil) {
+            const std::uint32_t i = firing_;
+            const Node n = nodes_[i];
+            firing_ = n.next;
+            release(i);
+            if (n.slot == kCancelled) continue;
+            --size_;
+            fn(n.entity, n.tag);
+        }
+    }
+
+    // Drops every timer and resets the clock to `now`
+    void clear(std::uint64_t now = 0);
+
+  private:
+    static constexpr std::uint32_t kBits = 6;
+    static constexpr std::uint32_t kSlots = 1u << kBits;
+    static constexpr std::uint32_t kLevels = 5;                    // 2^30 ticks, ~200 days at 60 Hz
+    static constexpr std::uint32_t kOverflow = kLevels * kSlots;   // list index of the overflow list
+    static constexpr std::uint32_t kFiring = kOverflow + 1;        // slot of a node handed to advance()
+    static constexpr std::uint32_t kCancelled = kOverflow + 2;     // cancelled while firing
+    static constexpr std::uint32_t kFree = kOverflow + 3;
+    static constexpr std::uint32_t kNil = ~std::uint32_t{0};
+
+    struct Node {
+        std::uint64_t due;
+        rt::ecs::Entity entity;
+        std::uint32_t tag;
+        std::uint32_t prev, next;
+        std::uint32_t slot; // list index, or one of kFiring/kCancelled/kFree
+        std::uint32_t generation;
+    };
+
+    // Advances now_, cascades the upper levels and detaches the chain due now
+    std::uint32_t tick();
+    void link(std::uint32_t i);
+    void unlink(std::uint32_t i);
+    void release(std::uint32_t i);
+    void cascade(std::uint32_t list);
+
+    std::vector<Node> nodes_;
+    std::vector<std::uint32_t> free_;
+    std::array<std::uint32_t, kOverflow + 1> heads_ = filled();
+    std::array<std::uint32_t, kOverflow + 1> tails_ = filled();
+    std::uint64_t now_ = 0;
+    std::size_t size_ = 0;
+    std::uint32_t firing_ = kNil;
+
+    static constexpr std::array<std::uint32_t, kOverflow + 1> filled() {
+        std::array<std::uint32_t, kOverflow + 1> a{};
+        for (auto& v : a) v = kNil;
+        return a;
+    }
+};
+
+}
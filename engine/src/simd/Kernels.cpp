@@ -0,0 +1,67 @@
+#include "rt/simd/Kernels.hpp"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define RT_SIMD_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RT_SIMD_SSE2 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define RT_SIMD_NEON 1
+#endif
+
+namespace rt::simd {
+
+void axpyScalar(float* out, const float* in, float k, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) out[i] += in[i] * k;
+}
+
+void axpy(float* out, const float* in, float k, std::size_t n) {
+    std::size_t i = 0;
+#if defined(RT_SIMD_AVX)
+    const __m256 vk = _mm256_set1_ps(k);
+    for (; i + 16 <= n; i += 16) {
+        __m256 a = _mm256_loadu_ps(out + i);
+        __m256 b = _mm256_loadu_ps(out + i + 8);
+        a = _mm256_add_ps(a, _mm256_mul_ps(_mm256_loadu_ps(in + i), vk));
+        b = _mm256_add_ps(b, _mm256_mul_ps(_mm256_loadu_ps(in + i + 8), vk));
+        _mm256_storeu_ps(out + i, a);
+        _mm256_storeu_ps(out + i + 8, b);
+    }
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_loadu_ps(out + i),
+                                                _mm256_mul_ps(_mm256_loadu_ps(in + i), vk)));
+    }
+#elif defined(RT_SIMD_SSE2)
+    const __m128 vk = _mm_set1_ps(k);
+    for (; i + 8 <= n; i += 8) {
+        __m128 a = _mm_loadu_ps(out + i);
+        __m128 b = _mm_loadu_ps(out + i + 4);
+        a = _mm_add_ps(a, _mm_mul_ps(_mm_loadu_ps(in + i), vk));
+        b = _mm_add_ps(b, _mm_mul_ps(_mm_loadu_ps(in + i + 4), vk));
+        _mm_storeu_ps(out + i, a);
+        _mm_storeu_ps(out + i + 4, b);
+    }
+#elif defined(RT_SIMD_NEON)
+    const float32x4_t vk = vdupq_n_f32(k);
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(out + i, vaddq_f32(vld1q_f32(out + i), vmulq_f32(vld1q_f32(in + i), vk)));
+    }
+#endif
+    axpyScalar(out + i, in + i, k, n - i);
+}
+
+const char* kernelName() {
+#if defined(RT_SIMD_AVX)
+    return "avx";
+#elif defined(RT_SIMD_SSE2)
+    return "sse2";
+#elif defined(RT_SIMD_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+}
@@ -0,0 +1,86 @@
+#include "rt/spatial/UniformGrid.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace rt::spatial {
+
+void UniformGrid::clear() {
+    boxes_.clear();
+    items_.clear();
+    cellStart_.clear();
+    cols_ = rows_ = 0;
+}
+
+std::uint32_t UniformGrid::insert(const Aabb& box) {
+    boxes_.push_back(box);
+    return static_cast<std::uint32_t>(boxes_.size() - 1);
+}
+
+UniformGrid::CellRange UniformGrid::cells(const Aabb& b) const {
+    auto clampCell = [](float v, std::size_t n) {
+        if (!(v > 0.f)) return std::size_t{0};
+        auto c = static_cast<std::size_t>(v);
+        return c < n ? c : n - 1;
+    };
+    return {clampCell((b.x - minX_) * invCellW_, cols_), clampCell((b.y - minY_) * invCellH_, rows_),
+            clampCell((b.x2 - minX_) * invCellW_, cols_), clampCell((b.y2 - minY_) * invCellH_, rows_)};
+}
+
+void UniformGrid::build() {
+    items_.clear();
+    if (boxes_.empty()) {
+        cols_ = rows_ = 0;
+        cellStart_.assign(1, 0);
+        return;
+    }
+    float maxX = boxes_[0].x2, maxY = boxes_[0].y2;
+    minX_ = boxes_[0].x;
+    minY_ = boxes_[0].y;
+    for (const auto& b : boxes_) {
+        minX_ = std::min(minX_, b.x);
+        minY_ = std::min(minY_, b.y);
+        maxX = std::max(maxX, b.x2);
+        maxY = std::max(maxY, b.y2);
+    }
+    auto axis = [this](float extent, float& inv) {
+        auto n = static_cast<std::size_t>(std::ceil(extent / cellSize_));
+        n = std::clamp<std::size_t>(n, 1, maxCells_);
+        inv = static_cast<float>(n) / std::max(extent, cellSize_);
+        return n;
+    };
+    cols_ = axis(maxX - minX_, invCellW_);
+    rows_ = axis(maxY - minY_, invCellH_);
+
+    // Counting pass, prefix sum, then fill in item order (keeps cells sorted)
+    cellStart_.assign(cols_ * rows_ + 1, 0);
+    for (const auto& b : boxes_) {
+        auto r = cells(b);
+        for (auto y = r.r0; y <= r.r1; ++y)
+            for (auto x = r.c0; x <= r.c1; ++x) ++cellStart_[y * cols_ + x + 1];
+    }
+    for (std::size_t i = 1; i < cellStart_.size(); ++i) cellStart_[i] += cellStart_[i - 1];
+    items_.resize(cellStart_.back());
+    fill_.assign(cellStart_.begin(), cellStart_.end() - 1);
+    for (std::uint32_t i = 0; i < boxes_.size(); ++i) {
+        auto r = cells(boxes_[i]);
+        for (auto y = r.r0; y <= r.r1; ++y)
+            for (auto x = r.c0; x <= r.c1; ++x) items_[fill_[y * cols_ + x]++] = i;
+    }
+}
+
+void UniformGrid::query(const Aabb& area, std::vector<std::uint32_t>& out) const {
+    out.clear();
+    if (cols_ == 0) return;
+    auto r = cells(area);
+    for (auto y = r.r0; y <= r.r1; ++y)
+        for (auto x = r.c0; x <= r.c1; ++x) {
+            auto cell = y * cols_ + x;
+            out.insert(out.end(), items_.begin() + cellStart_[cell], items_.begin() + cellStart_[cell + 1]);
+        }
+    if (r.c0 != r.c1 || r.r0 != r.r1) {
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    }
+}
+
+}
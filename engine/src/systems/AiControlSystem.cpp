@@ -12,8 +12,7 @@ void AiControlSystem::update(rt::ecs::Registry& r, float dt) {
     constexpr std::uint8_t kLeft = 1 << 2;
     constexpr std::uint8_t kRight = 1 << 3;
 
-    auto& ctrls = r.storage<rt::components::AiController>().data();
-    for (auto& [e, c] : ctrls) {
+    r.view<const rt::components::AiController>().each([&](rt::ecs::Entity e, const rt::components::AiController& c) {
         float vx = 0.f, vy = 0.f;
         if (c.bits & kLeft)  vx -= c.speed;
         if (c.bits & kRight) vx += c.speed;
@@ -21,5 +20,5 @@ void AiControlSystem::update(rt::ecs::Registry& r, float dt) {
         if (c.bits & kDown)  vy += c.speed;
         if (auto* v = r.get<rt::components::Velocity>(e)) { v->vx = vx; v->vy = vy; }
         else { r.emplace<rt::components::Velocity>(e, {vx, vy}); }
-    }
+    });
 }
@@ -6,11 +6,9 @@
 using namespace rt::systems;
 
 void MovementSystem::update(rt::ecs::Registry& r, float dt) {
-    auto& velocities = r.storage<rt::components::Velocity>().data();
-    for (auto& [e, v] : velocities) {
-        auto* p = r.get<rt::components::Position>(e);
-        if (!p) continue;
-        p->x += v.vx * dt;
-        p->y += v.vy * dt;
-    }
+    r.view<const rt::components::Velocity, rt::components::Position>().each(
+        [dt](const rt::components::Velocity& v, rt::components::Position& p) {
+        p.x += v.vx * dt;
+        p.y += v.vy * dt;
+    });
 }
@@ -12,8 +12,7 @@ void PlayerControlSystem::update(rt::ecs::Registry& r, float dt) {
     constexpr std::uint8_t kLeft = 1 << 2;
     constexpr std::uint8_t kRight = 1 << 3;
 
-    auto& ctrls = r.storage<rt::components::Controller>().data();
-    for (auto& [e, c] : ctrls) {
+    r.view<const rt::components::Controller>().each([&](rt::ecs::Entity e, const rt::components::Controller& c) {
         float vx = 0.f, vy = 0.f;
         if (c.bits & kLeft)  vx -= c.speed;
         if (c.bits & kRight) vx += c.speed;
@@ -22,5 +21,5 @@ void PlayerControlSystem::update(rt::ecs::Registry& r, float dt) {
         auto* v = r.get<rt::components::Velocity>(e);
         if (!v) { r.emplace<rt::components::Velocity>(e, {vx, vy}); }
         else { v->vx = vx; v->vy = vy; }
-    }
+    });
 }
@@ -0,0 +1,114 @@
+#include "rt/timer/TimerWheel.hpp"
+#include <bit>
+
+using namespace rt::timer;
+
+TimerWheel::Id TimerWheel::schedule(std::uint64_t due, rt::ecs::Entity e, std::uint32_t tag) {
+    if (due <= now_) due = now_ + 1;
+    std::uint32_t i;
+    if (!free_.empty()) {
+        i = free_.back();
+        free_.pop_back();
+    } else {
+        i = static_cast<std::uint32_t>(nodes_.size());
+        nodes_.push_back(Node{0, 0, 0, kNil, kNil, kFree, 0});
+    }
+    auto& n = nodes_[i];
+    n.due = due;
+    n.entity = e;
+    n.tag = tag;
+    link(i);
+    ++size_;
+    return Id{n.generation} << 32 | (Id{i} + 1);
+}
+
+bool TimerWheel::cancel(Id id) {
+    if (id == kNone) return false;
+    const auto i = static_cast<std::uint32_t>(id & 0xFFFFFFFFu) - 1;
+    if (i >= nodes_.size() || nodes_[i].generation != static_cast<std::uint32_t>(id >> 32)) return false;
+    auto& n = nodes_[i];
+    if (n.slot == kFree || n.slot == kCancelled) return false;
+    --size_;
+    if (n.slot == kFiring) {
+        // Still on the chain advance() is walking; it releases the node
+        n.slot = kCancelled;
+        return true;
+    }
+    unlink(i);
+    release(i);
+    return true;
+}
+
+void TimerWheel::clear(std::uint64_t now) {
+    nodes_.clear();
+    free_.clear();
+    heads_ = filled();
+    tails_ = filled();
+    now_ = now;
+    size_ = 0;
+    firing_ = kNil;
+}
+
+// Upper levels are cascaded top-down, so a timer can drop several levels on
+// the same tick and still land in the level-0 slot that is detached next
+std::uint32_t TimerWheel::tick() {
+    ++now_;
+    std::uint32_t boundary = 0; // levels whose slot turned over
+    while (boundary + 1 < kLevels && (now_ & ((std::uint64_t{1} << (kBits * (boundary + 1))) - 1)) == 0)
+        ++boundary;
+    if (boundary + 1 == kLevels && (now_ & ((std::uint64_t{1} << (kBits * kLevels)) - 1)) == 0)
+        cascade(kOverflow);
+    for (auto l = boundary; l >= 1; --l)
+        cascade(l * kSlots + static_cast<std::uint32_t>((now_ >> (kBits * l)) & (kSlots - 1)));
+
+    const auto list = static_cast<std::uint32_t>(now_ & (kSlots - 1));
+    const auto head = heads_[list];
+    for (auto i = head; i != kNil; i = nodes_[i].next) nodes_[i].slot = kFiring;
+    heads_[list] = tails_[list] = kNil;
+    return head;
+}
+
+void TimerWheel::cascade(std::uint32_t list) {
+    auto i = heads_[list];
+    heads_[list] = tails_[list] = kNil;
+    while (i != kNil) {
+        const auto next = nodes_[i].next;
+        link(i);
+        i = next;
+    }
+}
+
+// Appends to the list of the level where `due` first differs from now_
+void TimerWheel::link(std::uint32_t i) {
+    auto& n = nodes_[i];
+    const std::uint64_t diff = n.due ^ now_;
+    std::uint32_t list;
+    if (diff < kSlots) {
+        list = static_cast<std::uint32_t>(n.due & (kSlots - 1));
+    } else {
+        const auto level = static_cast<std::uint32_t>((std::bit_width(diff) - 1) / kBits);
+        list = level >= kLevels
+            ? kOverflow
+            : level * kSlots + static_cast<std::uint32_t>((n.due >> (kBits * level)) & (kSlots - 1));
+    }
+    n.slot = list;
+    n.next = kNil;
+    n.prev = tails_[list];
+    if (n.prev != kNil) nodes_[n.prev].next = i;
+    else heads_[list] = i;
+    tails_[list] = i;
+}
+
+void TimerWheel::unlink(std::uint32_t i) {
+    auto& n = nodes_[i];
+    if (n.prev != kNil) nodes_[n.prev].next = n.next;
+    else heads_[n.slot] = n.next;
+    if (n.next != kNil) nodes_[n.next].prev = n.prev;
+    else tails_[n.slot] = n.prev;
+}
+
+void TimerWheel::release(std::uint32_t i) {
+    nodes_[i].slot = kFree;
+    ++nodes_[i].generation;
+    free_.push_back(i);
+}
@@ -0,0 +1,86 @@
+#include <cstdint>
+#include <vector>
+#include "Check.hpp"
+#include "rt/ecs/Registry.hpp"
+
+using rt::ecs::Entity;
+using rt::ecs::Registry;
+
+namespace {
+
+struct Pos {
+    float x = 0.f, y = 0.f;
+};
+struct Vel {
+    float vx = 0.f, vy = 0.f;
+};
+
+template <typename C>
+std::vector<Entity> changedSince(Registry& r, std::uint32_t since) {
+    std::vector<Entity> out;
+    r.changed<C>(since, [&](Entity e, C&) { out.push_back(e); });
+    return out;
+}
+
+void stamps() {
+    Registry r;
+    const Entity a = r.create(), b = r.create(), c = r.create();
+    r.emplace<Pos>(a);
+    r.emplace<Pos>(b);
+    r.emplace<Pos>(c);
+    CHECK(changedSince<Pos>(r, r.tick() - 1).size() == 3);
+
+    // Writes up to now are at or below `since`, later ones above
+    std::uint32_t since = r.advanceTick();
+    CHECK(changedSince<Pos>(r, since).empty());
+
+    // get() and views, mutable or not, do not stamp
+    r.get<Pos>(a)->x = 1.f;
+    const auto& pool = r.storage<Pos>();
+    (void)pool.get(b)->x;
+    r.view<Pos>().each([](Pos& p) { p.y += 1.f; });
+    CHECK(changedSince<Pos>(r, since).empty());
+
+    // touch() does, and so does replacing through emplace()
+    r.touch<Pos>(a);
+    r.emplace<Pos>(c, Pos{5.f, 5.f});
+    CHECK((changedSince<Pos>(r, since) == std::vector<Entity>{a, c}));
+    CHECK(r.storage<Pos>().version(a) == r.tick());
+    CHECK(r.storage<Pos>().version(b) < r.tick());
+
+    // Next tick: touchRange stamps dense positions
+    since = r.advanceTick();
+    r.storage<Pos>().touchRange(1, 3);
+    CHECK(changedSince<Pos>(r, since).size() == 2);
+    CHECK(changedSince<Pos>(r, since).front() == r.storage<Pos>().entities()[1]);
+
+    // A pool never created reports nothing
+    CHECK(changedSince<Vel>(r, 0).empty());
+}
+
+// Non-const group components are stamped for the walked range, const ones not
+void groupWalks() {
+    Registry r;
+    for (int i = 0; i < 6; ++i) {
+        const Entity e = r.create();
+        r.emplace<Pos>(e);
+        if (i % 2) r.emplace<Vel>(e);
+    }
+    auto moving = r.group<Pos, const Vel>();
+    const std::uint32_t since = r.advanceTick();
+    moving.each([](Pos& p, const Vel& v) { p.x += v.vx; });
+    CHECK(changedSince<Pos>(r, since).size() == 3);
+    CHECK(changedSince<Vel>(r, since).empty());
+
+    const std::uint32_t later = r.advanceTick();
+    moving.touch<Pos>(0, 1);
+    CHECK((changedSince<Pos>(r, later) == std::vector<Entity>{moving.entity(0)}));
+}
+
+}
+
+int main() {
+    stamps();
+    groupWalks();
+    return rt::test::report();
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <cstdio>
+
+// Minimal checks for the engine test executables: a failed CHECK prints where
+// it failed and the remaining checks still run; main() returns report().
+namespace rt::test {
+
+inline int failures = 0;
+
+inline void fail(const char* expr, const char* file, int line) {
+    std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, expr);
+    ++failures;
+}
+
+inline int report() {
+    if (failures) std::fprintf(stderr, "%d check(s) failed\n", failures);
+    return failures ? 1 : 0;
+}
+
+}
+
+#define CHECK(...) \
+    ((__VA_ARGS__) ? void() : rt::test::fail(#__VA_ARGS__, __FILE__, __LINE__))
+
+// Expression must throw an exception of the given type
+#define CHECK_THROWS(Exception, ...)                                     \
+    do {                                                                 \
+        bool thrown_ = false;                                            \
+        try {                                                            \
+            (void)(__VA_ARGS__);                                         \
+        } catch (const Exception&) {                                     \
+            thrown_ = true;                                              \
+        }                                                                \
+        if (!thrown_) rt::test::fail(#__VA_ARGS__ " throws " #Exception, __FILE__, __LINE__); \
+    } while (0)
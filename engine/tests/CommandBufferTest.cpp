@@ -0,0 +1,62 @@
+#include <cstddef>
+#include "Check.hpp"
+#include "rt/ecs/Registry.hpp"
+
+using rt::ecs::Entity;
+using rt::ecs::Registry;
+
+namespace {
+
+struct Pos {
+    float x = 0.f, y = 0.f;
+};
+struct Tagged {
+    int by = 0;
+};
+
+// Listener recording into the buffer being flushed, enough times that its
+// command and payload vectors reallocate during the flush
+void tagOnConstruct(Registry& r, Entity e) {
+    r.commands().emplace<Tagged>(e, Tagged{1});
+    for (int i = 0; i < 8; ++i) r.commands().emplace<Tagged>(r.create(), Tagged{2});
+}
+
+void listenerRecordsDuringFlush() {
+    Registry r;
+    r.onConstruct<Pos>().connect<&tagOnConstruct>();
+    constexpr std::size_t kCount = 200;
+    for (std::size_t i = 0; i < kCount; ++i) r.commands().emplace<Pos>(r.create(), Pos{static_cast<float>(i), 0.f});
+    r.commands().flush();
+
+    CHECK(r.commands().empty());
+    CHECK(r.storage<Pos>().size() == kCount);
+    CHECK(r.storage<Tagged>().size() == kCount * 9);
+    std::size_t tagged = 0;
+    r.view<const Pos, const Tagged>().each([&](const Pos& p, const Tagged& t) {
+        tagged += t.by == 1 && p.x >= 0.f;
+    });
+    CHECK(tagged == kCount);
+}
+
+void listenerRecordsDuringSpawnFlush() {
+    Registry r;
+    r.onConstruct<Pos>().connect<&tagOnConstruct>();
+    const rt::ecs::Prefab<Pos> prefab{Pos{}};
+    r.commands().spawn(prefab, 100, [](std::size_t i, Entity, Pos& p) { p.x = static_cast<float>(i); });
+    r.commands().flush();
+
+    CHECK(r.commands().empty());
+    CHECK(r.storage<Pos>().size() == 100);
+    CHECK(r.storage<Tagged>().size() == 900);
+    float sum = 0.f;
+    r.view<const Pos, const Tagged>().each([&](const Pos& p, const Tagged&) { sum += p.x; });
+    CHECK(sum == 4950.f); // every spawned row kept its own value
+}
+
+}
+
+int main() {
+    listenerRecordsDuringFlush();
+    listenerRecordsDuringSpawnFlush();
+    return rt::test::report();
+}
@@ -0,0 +1,69 @@
+#include <memory>
+#include "Check.hpp"
+#include "rt/ecs/Registry.hpp"
+#include "rt/game/Components.hpp"
+#include "rt/game/Systems.hpp"
+
+using namespace rt::game;
+using rt::ecs::Entity;
+using rt::ecs::Registry;
+
+namespace {
+
+constexpr float kDt = 1.f / 60.f;
+
+// Ticks of `dt` after which a `seconds` effect granted now is gone
+template <typename Effect>
+int lifetime(Registry& r, Entity e, float dt) {
+    int ticks = 0;
+    while (r.has<Effect>(e) && ticks < 1000) {
+        r.update(dt);
+        ++ticks;
+    }
+    return ticks;
+}
+
+// Each effect keeps its own clock: InfiniteFireSystem running every other
+// tick (with twice the dt) must not change how long invincibility lasts
+// (granted on a tick where it ran and on one where it did not)
+void effectsLastTheirDuration(int warmup) {
+    Registry r;
+    r.addSystem(std::make_unique<InvincibilitySystem>());
+    r.addSystem(std::make_unique<InfiniteFireSystem>(), rt::ecs::Schedule{2});
+    const Entity player = r.create();
+    r.emplace<Shooter>(player);
+    for (int i = 0; i < warmup; ++i) r.update(kDt);
+
+    float seconds = 1.f;
+    const auto expected = static_cast<int>(countdown(seconds, kDt));
+    grantInvincible(r, player, 1.f);
+    CHECK(lifetime<Invincible>(r, player, kDt) == expected);
+
+    grantInfiniteFire(r, player, 1.f);
+    const int fire = lifetime<InfiniteFire>(r, player, kDt);
+    CHECK(fire >= expected - 2 && fire <= expected + 2);
+}
+
+// Extending an effect moves its expiry; the earlier timer no longer ends it
+void extendingKeepsTheLaterExpiry() {
+    Registry r;
+    r.addSystem(std::make_unique<InvincibilitySystem>());
+    const Entity player = r.create();
+    r.update(kDt);
+    grantInvincible(r, player, 0.5f);
+    for (int i = 0; i < 10; ++i) r.update(kDt);
+    grantInvincible(r, player, 1.f);
+    grantInvincible(r, player, 0.25f); // never shortens
+
+    float seconds = 1.f;
+    CHECK(lifetime<Invincible>(r, player, kDt) == static_cast<int>(countdown(seconds, kDt)));
+}
+
+}
+
+int main() {
+    effectsLastTheirDuration(10);
+    effectsLastTheirDuration(11);
+    extendingKeepsTheLaterExpiry();
+    return rt::test::report();
+}
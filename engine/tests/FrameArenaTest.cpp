@@ -0,0 +1,101 @@
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+#include "Check.hpp"
+#include "rt/memory/FrameArena.hpp"
+
+using rt::memory::FrameArena;
+
+namespace {
+
+bool alignedTo(const void* p, std::size_t align) {
+    return reinterpret_cast<std::uintptr_t>(p) % align == 0;
+}
+
+// Upstream that counts what is still outstanding, so leaks show up
+class CountingResource final : public std::pmr::memory_resource {
+  public:
+    int live = 0;
+
+  private:
+    void* do_allocate(std::size_t bytes, std::size_t align) override {
+        ++live;
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+    void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+        --live;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+// Bumps are contiguous apart from alignment padding, which used() counts
+void bumpsAreAligned() {
+    FrameArena arena(1024);
+    auto* a = static_cast<std::byte*>(arena.allocate(1, 1));
+    auto* b = static_cast<std::byte*>(arena.allocate(8, 8));
+    auto* c = static_cast<std::byte*>(arena.allocate(3, 1));
+    auto* d = static_cast<std::byte*>(arena.allocate(64, 64));
+    CHECK(alignedTo(b, 8));
+    CHECK(alignedTo(d, 64));
+    CHECK(b - a == 8);
+    CHECK(c == b + 8);
+    CHECK(d > c && d - c < 64 + 3);
+    CHECK(arena.used() == static_cast<std::size_t>(d + 64 - a));
+    CHECK(arena.upstreamAllocations() == 1);
+}
+
+void spillsWhenFull() {
+    CountingResource upstream;
+    {
+        FrameArena arena(256, &upstream);
+        void* first = arena.allocate(200, 8);
+        void* spilled = arena.allocate(100, 8);
+        void* big = arena.allocate(1000, 128);
+        CHECK(first != nullptr);
+        CHECK(alignedTo(spilled, 8));
+        CHECK(alignedTo(big, 128));
+        CHECK(arena.upstreamAllocations() == 3);
+        CHECK(upstream.live == 3);
+        CHECK(arena.used() == 1300);
+        CHECK(arena.capacity() == 256); // grows only at reset()
+    }
+    CHECK(upstream.live == 0);
+}
+
+// After a frame that spilled, reset() regrows the block so the same frame
+// again fits without the upstream
+void resetRegrows() {
+    CountingResource upstream;
+    FrameArena arena(128, &upstream);
+    const auto frame = [&] {
+        std::pmr::vector<int> v(&arena);
+        for (int i = 0; i < 100; ++i) v.push_back(i);
+        std::pmr::vector<double> w(50, 1.0, &arena);
+        return v.size() + w.size();
+    };
+    CHECK(frame() == 150);
+    const std::size_t peak = arena.used();
+    arena.reset();
+    CHECK(arena.peak() == peak);
+    CHECK(arena.capacity() >= peak);
+    CHECK(arena.used() == 0);
+    CHECK(upstream.live == 1); // spills went back, one grown block remains
+
+    const std::uint64_t before = arena.upstreamAllocations();
+    for (int i = 0; i < 3; ++i) {
+        CHECK(frame() == 150);
+        arena.reset();
+    }
+    CHECK(arena.upstreamAllocations() == before);
+    CHECK(upstream.live == 1);
+}
+
+}
+
+int main() {
+    bumpsAreAligned();
+    spillsWhenFull();
+    resetRegrows();
+    return rt::test::report();
+}
@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "Check.hpp"
+#include "rt/ecs/Registry.hpp"
+#include "rt/jobs/JobSystem.hpp"
+
+using rt::jobs::JobSystem;
+
+namespace {
+
+struct Pos {
+    float x = 0.f;
+};
+struct Hidden {};
+
+std::vector<std::uint64_t> squares(JobSystem& jobs, std::size_t n, std::size_t chunk) {
+    std::vector<std::uint64_t> out(n, 0);
+    jobs.parallelFor(n, chunk, [&](std::size_t b, std::size_t e) {
+        for (auto i = b; i < e; ++i) out[i] = std::uint64_t{i} * i + 1;
+    });
+    return out;
+}
+
+// Whoever runs a chunk, the result matches the inline run, and the chunks
+// tile [0, count) exactly
+void oneWorkerIsDeterministic() {
+    JobSystem inline0(0);
+    const auto expected = squares(inline0, 10'000, 64);
+    JobSystem jobs(1);
+    for (int run = 0; run < 20; ++run) CHECK(squares(jobs, 10'000, 64) == expected);
+
+    std::vector<std::pair<std::size_t, std::size_t>> chunks(100);
+    std::atomic<std::size_t> next{0};
+    jobs.parallelFor(1000, 10, [&](std::size_t b, std::size_t e) { chunks[next++] = {b, e}; });
+    CHECK(next == 100);
+    std::sort(chunks.begin(), chunks.end());
+    for (std::size_t k = 0; k < chunks.size(); ++k)
+        CHECK(chunks[k] == std::pair<std::size_t, std::size_t>{k * 10, k * 10 + 10});
+}
+
+// The other tasks still run to completion before the caller sees the error
+void exceptionReachesCaller() {
+    for (std::size_t workers : {0u, 1u, 3u}) {
+        JobSystem jobs(workers);
+        std::atomic<int> ran{0};
+        std::vector<JobSystem::Task> tasks;
+        tasks.push_back([] { throw std::runtime_error("task"); });
+        for (int i = 0; i < 8; ++i) tasks.push_back([&] { ++ran; });
+        CHECK_THROWS(std::runtime_error, jobs.run(tasks));
+        if (workers > 0) CHECK(ran == 8);
+
+        CHECK_THROWS(std::logic_error, jobs.parallelFor(1000, 10, [](std::size_t b, std::size_t e) {
+            if (b <= 500 && 500 < e) throw std::logic_error("chunk");
+        }));
+
+        // The pool is still usable afterwards
+        ran = 0;
+        jobs.run({[&] { ++ran; }, [&] { ++ran; }});
+        CHECK(ran == 2);
+    }
+}
+
+// A task waiting on nested work runs queued tasks instead of blocking, so
+// this completes even with a single worker
+void nestedCalls() {
+    for (std::size_t workers : {0u, 1u, 3u}) {
+        JobSystem jobs(workers);
+        std::atomic<std::uint64_t> sum{0};
+        std::vector<JobSystem::Task> outer;
+        for (int t = 0; t < 4; ++t)
+            outer.push_back([&] {
+                jobs.parallelFor(1000, 50, [&](std::size_t b, std::size_t e) {
+                    jobs.run({[&, b, e] { sum += e - b; }});
+                });
+            });
+        jobs.run(outer);
+        CHECK(sum == 4000);
+    }
+}
+
+void zeroWorkersRunInline() {
+    JobSystem jobs(0);
+    CHECK(jobs.workerCount() == 0);
+    const auto caller = std::this_thread::get_id();
+    std::vector<int> order;
+    bool onCaller = true;
+    std::vector<JobSystem::Task> tasks;
+    for (int i = 0; i < 5; ++i)
+        tasks.push_back([&, i] {
+            order.push_back(i);
+            onCaller = onCaller && std::this_thread::get_id() == caller;
+        });
+    jobs.run(tasks);
+    CHECK((order == std::vector<int>{0, 1, 2, 3, 4}));
+
+    // One call over the whole range, whatever the chunk
+    std::vector<std::pair<std::size_t, std::size_t>> chunks;
+    jobs.parallelFor(1000, 10, [&](std::size_t b, std::size_t e) {
+        chunks.emplace_back(b, e);
+        onCaller = onCaller && std::this_thread::get_id() == caller;
+    });
+    CHECK((chunks == std::vector<std::pair<std::size_t, std::size_t>>{{0, 1000}}));
+    CHECK(onCaller);
+}
+
+// Every entity of the view is visited exactly once, none outside it, and the
+// visits are credited to the calling thread
+void parallelForViewVisitsEachOnce() {
+    rt::ecs::Registry r;
+    std::vector<rt::ecs::Entity> entities;
+    for (int i = 0; i < 5000; ++i) {
+        const auto e = r.create();
+        entities.push_back(e);
+        r.emplace<Pos>(e);
+        if (i % 3 == 0) r.emplace<Hidden>(e);
+    }
+    for (std::size_t workers : {0u, 1u, 4u}) {
+        JobSystem jobs(workers);
+        for (JobSystem* pool : {static_cast<JobSystem*>(nullptr), &jobs}) {
+            for (auto e : entities) r.get<Pos>(e)->x = 0.f;
+            std::atomic<int> visits{0};
+            const auto before = rt::ecs::detail::work.processed;
+            rt::jobs::parallel_for(pool, r.view<Pos>(rt::ecs::exclude<Hidden>), 64,
+                                   [&](rt::ecs::Entity, Pos& p) {
+                                       p.x += 1.f;
+                                       ++visits;
+                                   });
+            CHECK(visits == 5000 - 1667);
+            CHECK(rt::ecs::detail::work.processed - before == 5000u - 1667u);
+            bool exact = true;
+            for (std::size_t i = 0; i < entities.size(); ++i)
+                exact = exact && r.get<Pos>(entities[i])->x == (i % 3 == 0 ? 0.f : 1.f);
+            CHECK(exact);
+        }
+    }
+}
+
+}
+
+int main() {
+    oneWorkerIsDeterministic();
+    exceptionReachesCaller();
+    nestedCalls();
+    zeroWorkersRunInline();
+    parallelForViewVisitsEachOnce();
+    return rt::test::report();
+}
@@ -0,0 +1,97 @@
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "Check.hpp"
+#include "rt/jobs/MpscRing.hpp"
+
+using rt::jobs::MpscRing;
+
+namespace {
+
+void capacityRoundsUp() {
+    CHECK(MpscRing<int>(1000).capacity() == 1024);
+    CHECK(MpscRing<int>(8).capacity() == 8);
+    CHECK(MpscRing<int>(0).capacity() == 2);
+}
+
+void pushFailsWhenFull() {
+    MpscRing<int> ring(8);
+    for (int i = 0; i < 8; ++i) CHECK(ring.tryPush(i));
+    CHECK(!ring.tryPush(99));
+    int v = -1;
+    CHECK(ring.tryPop(v) && v == 0);
+    CHECK(ring.tryPush(8)); // one place freed
+    CHECK(!ring.tryPush(99));
+}
+
+// Many laps over a small ring, at varying fill levels, keep FIFO order
+void wrapsAroundInOrder() {
+    MpscRing<std::uint32_t> ring(4);
+    std::uint32_t next = 0, expect = 0, v = 0;
+    for (int lap = 0; lap < 1000; ++lap) {
+        const int burst = 1 + lap % 4;
+        for (int i = 0; i < burst; ++i) CHECK(ring.tryPush(next++));
+        while (ring.tryPop(v)) CHECK(v == expect++);
+    }
+    CHECK(expect == next);
+    CHECK(!ring.tryPop(v));
+}
+
+// A producer refilling the ring from inside drain() cannot keep it going
+void drainStopsAfterOneRing() {
+    MpscRing<int> ring(8);
+    for (int i = 0; i < 8; ++i) ring.tryPush(i);
+    int pushed = 8;
+    const std::size_t n = ring.drain([&](int) { ring.tryPush(pushed++); });
+    CHECK(n == ring.capacity());
+    CHECK(ring.drain([](int) {}) == 8); // what was refilled is still there
+}
+
+// K producers, one consumer: every record arrives exactly once, and each
+// producer's records in the order it pushed them
+void producersLoseNothing() {
+    constexpr std::uint32_t kProducers = 4;
+    constexpr std::uint32_t kPerProducer = 20000;
+    struct Record {
+        std::uint32_t producer = 0;
+        std::uint32_t seq = 0;
+    };
+    MpscRing<Record> ring(64);
+    std::vector<std::thread> producers;
+    for (std::uint32_t p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&ring, p] {
+            for (std::uint32_t s = 0; s < kPerProducer; ++s)
+                while (!ring.tryPush(Record{p, s})) std::this_thread::yield();
+        });
+    }
+    std::vector<std::uint32_t> next(kProducers, 0);
+    std::uint64_t received = 0;
+    int outOfOrder = 0;
+    bool capped = true;
+    while (received < std::uint64_t{kProducers} * kPerProducer) {
+        const std::size_t n = ring.drain([&](const Record& r) {
+            if (r.producer >= kProducers || r.seq != next[r.producer]) ++outOfOrder;
+            else ++next[r.producer];
+        });
+        capped = capped && n <= ring.capacity();
+        received += n;
+        if (n == 0) std::this_thread::yield();
+    }
+    for (auto& t : producers) t.join();
+    Record extra;
+    CHECK(!ring.tryPop(extra));
+    CHECK(outOfOrder == 0);
+    CHECK(capped);
+    for (auto n : next) CHECK(n == kPerProducer);
+}
+
+}
+
+int main() {
+    capacityRoundsUp();
+    pushFailsWhenFull();
+    wrapsAroundInOrder();
+    drainStopsAfterOneRing();
+    producersLoseNothing();
+    return rt::test::report();
+}
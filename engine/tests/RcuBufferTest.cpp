@@ -0,0 +1,117 @@
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "Check.hpp"
+#include "rt/jobs/RcuBuffer.hpp"
+
+using rt::jobs::RcuBuffer;
+
+namespace {
+
+void publish(RcuBuffer<int, 4>& buf, int v) {
+    int* slot = buf.beginWrite();
+    if (!slot) return;
+    *slot = v;
+    buf.publish();
+}
+
+void emptyBeforeFirstPublish() {
+    RcuBuffer<int, 4> buf;
+    CHECK(!buf.read());
+    publish(buf, 7);
+    auto r = buf.read();
+    CHECK(r && *r == 7);
+    CHECK(buf.published() == 1);
+}
+
+// A pinned slot is never handed to the writer, however often it publishes
+void pinnedReaderKeepsItsValue() {
+    RcuBuffer<int, 4> buf;
+    publish(buf, 1);
+    auto pinned = buf.read();
+    for (int v = 2; v < 50; ++v) {
+        publish(buf, v);
+        CHECK(*pinned == 1);
+    }
+    CHECK(*buf.read() == 49);
+}
+
+// With Slots = 4, readers pinning three old values leave the writer nothing
+// to fill: the fourth slot is the published one
+void writerRunsOutOfSlots() {
+    RcuBuffer<int, 4> buf;
+    publish(buf, 1);
+    auto a = buf.read();
+    publish(buf, 2);
+    auto b = buf.read();
+    publish(buf, 3);
+    auto c = buf.read();
+    publish(buf, 4);
+    CHECK(buf.beginWrite() == nullptr);
+    buf.publish(); // no slot taken: a no-op
+    CHECK(buf.published() == 4);
+    CHECK(*a == 1 && *b == 2 && *c == 3 && *buf.read() == 4);
+
+    b = {}; // released: its slot can be written again
+    int* slot = buf.beginWrite();
+    CHECK(slot != nullptr);
+    if (slot) {
+        *slot = 5;
+        buf.publish();
+    }
+    CHECK(*a == 1 && *c == 3 && *buf.read() == 5);
+}
+
+// Every published value is an array filled with one number; a reader that
+// sees two different numbers in it read a slot being rewritten
+void noTornReads() {
+    using Value = std::array<std::uint64_t, 64>;
+    constexpr int kReaders = 3;
+    constexpr std::uint64_t kWrites = 20000;
+    RcuBuffer<Value, kReaders + 2> buf;
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+    std::atomic<std::uint64_t> reads{0};
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < kReaders; ++i) {
+        readers.emplace_back([&] {
+            std::uint64_t last = 0;
+            while (!done.load(std::memory_order_acquire)) {
+                auto r = buf.read();
+                if (!r) continue;
+                const std::uint64_t v = (*r)[0];
+                for (auto x : *r)
+                    if (x != v) torn.fetch_add(1);
+                if (v < last) torn.fetch_add(1); // values only move forward
+                last = v;
+                reads.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (std::uint64_t v = 1; v <= kWrites; ++v) {
+        Value* slot = buf.beginWrite();
+        CHECK(slot != nullptr); // Slots = readers + 2 always leaves one
+        if (!slot) continue;
+        slot->fill(v);
+        buf.publish();
+        if (v % 64 == 0) std::this_thread::yield();
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& t : readers) t.join();
+    CHECK(torn.load() == 0);
+    CHECK(reads.load() > 0);
+    CHECK((*buf.read())[0] == kWrites);
+}
+
+}
+
+int main() {
+    emptyBeforeFirstPublish();
+    pinnedReaderKeepsItsValue();
+    writerRunsOutOfSlots();
+    noTornReads();
+    return rt::test::report();
+}
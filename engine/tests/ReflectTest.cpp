@@ -0,0 +1,131 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <tuple>
+#include "Check.hpp"
+#include "common/Protocol.hpp"
+#include "rt/ecs/Types.hpp"
+#include "rt/game/Components.hpp"
+#include "rt/reflect/Binary.hpp"
+
+using namespace rt::game;
+
+namespace wire {
+
+// Position in 1/8 px (int16), velocity in 1/16 px/s (int8), flags as is
+struct Motion {
+    float x = 0.f;
+    float vx = 0.f;
+    std::uint8_t flags = 0;
+};
+
+constexpr auto rtReflect(rt::reflect::Tag<Motion>) {
+    return std::make_tuple(rt::reflect::quantized<std::int16_t, 8>("x", &Motion::x),
+                           rt::reflect::quantized<std::int8_t, 16>("vx", &Motion::vx),
+                           rt::reflect::field("flags", &Motion::flags));
+}
+
+}
+
+using wire::Motion;
+
+namespace {
+
+// The State wire format is the reflected components back to back
+void writeMatchesPackedEntity() {
+    const rt::ecs::Entity id = rt::ecs::makeEntity(42, 3);
+    const NetType nt{rtype::net::EntityType::Enemy};
+    const Transform tr{12.5f, -3.f};
+    const Velocity ve{-60.f, 0.25f};
+    const ColorRGBA co{0x11223344u};
+
+    rtype::net::PackedEntity expected{};
+    expected.id = id;
+    expected.type = nt.type;
+    expected.x = tr.x;
+    expected.y = tr.y;
+    expected.vx = ve.vx;
+    expected.vy = ve.vy;
+    expected.rgba = co.rgba;
+
+    static_assert(rt::reflect::wireSizeOf<rt::ecs::Entity, NetType, Transform, Velocity, ColorRGBA> ==
+                  sizeof(rtype::net::PackedEntity));
+    std::array<std::byte, sizeof(rtype::net::PackedEntity)> bytes{};
+    std::byte* end = rt::reflect::write(bytes.data(), id, nt, tr, ve, co);
+    CHECK(end == bytes.data() + bytes.size());
+    CHECK(std::memcmp(bytes.data(), &expected, sizeof(expected)) == 0);
+
+    rt::ecs::Entity id2 = 0;
+    NetType nt2{};
+    Transform tr2;
+    Velocity ve2;
+    ColorRGBA co2;
+    const std::byte* in = rt::reflect::read(bytes.data(), id2, nt2, tr2, ve2, co2);
+    CHECK(in == bytes.data() + bytes.size());
+    CHECK(id2 == id && nt2.type == nt.type);
+    CHECK(tr2.x == tr.x && tr2.y == tr.y && ve2.vx == ve.vx && ve2.vy == ve.vy && co2.rgba == co.rgba);
+}
+
+void quantizedRoundTripAndClamp() {
+    static_assert(rt::reflect::wireSize<Motion>() == 2 + 1 + 1);
+    using X = std::tuple_element_t<0, decltype(rt::reflect::fields<Motion>())>;
+    using VX = std::tuple_element_t<1, decltype(rt::reflect::fields<Motion>())>;
+    CHECK(X::quantize(1.5f) == 12);
+    CHECK(X::quantize(-1.0625f) == -8); // 1/8 resolution, rounded
+    CHECK(X::quantize(1e9f) == std::numeric_limits<std::int16_t>::max());
+    CHECK(X::quantize(-1e9f) == std::numeric_limits<std::int16_t>::min());
+    CHECK(VX::quantize(100.f) == std::numeric_limits<std::int8_t>::max());
+    CHECK(VX::quantize(-100.f) == std::numeric_limits<std::int8_t>::min());
+
+    const Motion m{100.25f, -2.5f, 7};
+    std::array<std::byte, rt::reflect::wireSize<Motion>()> bytes{};
+    rt::reflect::write(bytes.data(), m);
+    Motion back;
+    rt::reflect::read(bytes.data(), back);
+    CHECK(back.x == 100.25f && back.vx == -2.5f && back.flags == 7);
+
+    const Motion far{5000.f, 9.f, 0}; // past both Int ranges
+    rt::reflect::write(bytes.data(), far);
+    rt::reflect::read(bytes.data(), back);
+    CHECK(back.x == 32767.f / 8.f);
+    CHECK(back.vx == 127.f / 16.f);
+}
+
+// Only fields whose encoding changed are in the mask, and a delta carries
+// exactly those
+void deltaHoldsChangedFields() {
+    const Motion before{10.f, 1.f, 1};
+    CHECK(rt::reflect::diff(before, before) == 0u);
+    CHECK(rt::reflect::diff(before, Motion{10.05f, 1.01f, 1}) == 0u); // below 1/8 and 1/16
+    CHECK(rt::reflect::diff(before, Motion{10.125f, 1.f, 1}) == 0b001u);
+    CHECK(rt::reflect::diff(before, Motion{10.f, 1.0625f, 1}) == 0b010u);
+    CHECK(rt::reflect::diff(before, Motion{10.f, 1.f, 2}) == 0b100u);
+    // Both sides clamp to the same value: no change on the wire
+    CHECK(rt::reflect::diff(Motion{5000.f, 0.f, 0}, Motion{6000.f, 0.f, 0}) == 0u);
+
+    const Motion now{12.f, 1.f, 4};
+    const std::uint32_t mask = rt::reflect::diff(before, now);
+    CHECK(mask == 0b101u);
+    CHECK(rt::reflect::deltaSize<Motion>(mask) == 3);
+    CHECK(rt::reflect::deltaSize<Motion>(0) == 0);
+    CHECK(rt::reflect::deltaSize<Motion>(0b111u) == rt::reflect::wireSize<Motion>());
+
+    std::array<std::byte, 8> bytes{};
+    const std::byte* end = rt::reflect::writeDelta(bytes.data(), now, mask);
+    CHECK(end == bytes.data() + 3);
+    Motion applied = before;
+    CHECK(rt::reflect::readDelta(bytes.data(), applied, mask) == end);
+    CHECK(applied.x == 12.f && applied.vx == 1.f && applied.flags == 4);
+    CHECK(rt::reflect::diff(applied, now) == 0u);
+}
+
+}
+
+int main() {
+    writeMatchesPackedEntity();
+    quantizedRoundTripAndClamp();
+    deltaHoldsChangedFields();
+    return rt::test::report();
+}
@@ -0,0 +1,89 @@
+#include <stdexcept>
+#include "Check.hpp"
+#include "rt/ecs/Registry.hpp"
+#include "rt/ecs/System.hpp"
+
+using rt::ecs::Entity;
+using rt::ecs::Registry;
+
+namespace {
+
+struct Pos {
+    float x = 0.f, y = 0.f;
+};
+struct Tag {};
+struct Before {};
+struct After {};
+struct Shared {
+    int value = 0;
+};
+struct Rng {};
+
+// A destroyed handle whose index went to a newer entity must not reach the
+// pools: neither take over the new owner's slot nor leave a component behind
+void emplaceThroughRecycledHandle() {
+    Registry r;
+    const Entity stale = r.create();
+    r.emplace<Pos>(stale, Pos{1.f, 1.f});
+    r.destroy(stale);
+
+    const Entity fresh = r.create();
+    CHECK(rt::ecs::entityIndex(fresh) == rt::ecs::entityIndex(stale));
+    CHECK(fresh != stale);
+    r.emplace<Pos>(fresh, Pos{2.f, 2.f});
+
+    CHECK_THROWS(std::logic_error, r.emplace<Pos>(stale, Pos{3.f, 3.f}));
+    CHECK_THROWS(std::logic_error, r.emplace<Tag>(stale));
+    CHECK(r.storage<Pos>().size() == 1);
+    CHECK(r.get<Pos>(fresh) && r.get<Pos>(fresh)->x == 2.f);
+    CHECK(r.get<Pos>(stale) == nullptr);
+    CHECK(r.storage<Tag>().size() == 0);
+    CHECK(!r.has<Tag>(fresh));
+
+    // Same through a free slot nobody reused yet
+    r.destroy(fresh);
+    CHECK_THROWS(std::logic_error, r.emplace<Pos>(fresh));
+    CHECK(r.storage<Pos>().size() == 0);
+}
+
+// Deferred emplaces on entities destroyed before the flush are dropped
+void deferredEmplaceOnDestroyedEntity() {
+    Registry r;
+    const Entity e = r.create();
+    r.commands().emplace<Pos>(e, Pos{1.f, 1.f});
+    r.destroy(e);
+    const Entity fresh = r.create();
+    r.commands().flush();
+    CHECK(r.storage<Pos>().size() == 0);
+    CHECK(r.get<Pos>(fresh) == nullptr);
+}
+
+// ctx() entries and resources draw from their own id sequence: they take no
+// component id, and their bits never clash with component bits
+void resourcesHaveTheirOwnIds() {
+    const auto before = rt::ecs::componentId<Before>();
+    Registry r;
+    r.ctx<Shared>().value = 3;
+    const auto a = rt::ecs::Access{}.writeCtx<Shared>().writeResource<Rng>();
+    CHECK(rt::ecs::componentId<After>() == before + 1);
+    CHECK(r.ctx<Shared>().value == 3);
+    CHECK(a.reads == 0 && a.writes == 0);
+    CHECK(a.resourceWrites != 0);
+
+    // Whatever bits the ids share, components and resources stay apart
+    const auto c = rt::ecs::Access{}.write<Before, After, Pos, Tag>();
+    CHECK(!a.conflicts(c) && !c.conflicts(a));
+    CHECK(a.conflicts(rt::ecs::Access{}.readCtx<Shared>()));
+    CHECK(rt::ecs::Access{}.readResource<Rng>().conflicts(a));
+    CHECK(!rt::ecs::Access{}.readResource<Rng>().conflicts(rt::ecs::Access{}.readCtx<Shared>()));
+    CHECK(rt::ecs::Access{}.destroys().conflicts(rt::ecs::Access{}.structural()));
+}
+
+}
+
+int main() {
+    emplaceThroughRecycledHandle();
+    deferredEmplaceOnDestroyedEntity();
+    resourcesHaveTheirOwnIds();
+    return rt::test::report();
+}
@@ -0,0 +1,120 @@
+#include <cstdint>
+#include <string>
+#include "Check.hpp"
+#include "rt/ecs/Registry.hpp"
+#include "rt/game/Components.hpp"
+
+using namespace rt::game;
+using rt::ecs::Entity;
+using rt::ecs::Registry;
+
+namespace {
+
+void populate(Registry& r, int players, int enemies) {
+    for (int i = 0; i < players; ++i) {
+        const Entity e = r.create();
+        r.emplace<Transform>(e, Transform{50.f, 100.f + 40.f * static_cast<float>(i)});
+        r.emplace<Velocity>(e);
+        r.emplace<NetType>(e, NetType{rtype::net::EntityType::Player});
+        r.emplace<ColorRGBA>(e);
+        r.emplace<IsPlayer>(e);
+        r.emplace<Name>(e, Name{"player" + std::to_string(i)});
+        r.emplace<Lives>(e, Lives{4});
+    }
+    for (int i = 0; i < enemies; ++i) {
+        const Entity e = r.create();
+        r.emplace<Transform>(e, Transform{900.f - static_cast<float>(i), static_cast<float>(i % 600)});
+        r.emplace<Velocity>(e, Velocity{-60.f, static_cast<float>(i % 7)});
+        r.emplace<NetType>(e, NetType{rtype::net::EntityType::Enemy});
+        r.emplace<ColorRGBA>(e, ColorRGBA{0xFF0000FFu});
+        r.emplace<EnemyTag>(e);
+        if (i % 3 == 0) r.destroy(e); // leave holes in the free list
+    }
+}
+
+// Order-sensitive digest of every live entity and the components it has
+std::uint64_t digest(Registry& r) {
+    std::uint64_t h = 1469598103934665603ull;
+    auto mix = [&](std::uint64_t v) { h = (h ^ v) * 1099511628211ull; };
+    for (Entity e : r.alive()) {
+        mix(e);
+        mix(r.signature(e));
+        if (auto* t = r.get<Transform>(e)) mix(static_cast<std::uint64_t>(t->x * 1000.f) ^ static_cast<std::uint64_t>(t->y));
+        if (auto* v = r.get<Velocity>(e)) mix(static_cast<std::uint64_t>(v->vx * 1000.f + v->vy));
+        if (auto* n = r.get<Name>(e)) mix(std::hash<std::string>{}(n->value));
+        if (auto* l = r.get<Lives>(e)) mix(l->value);
+    }
+    return h;
+}
+
+// Group positions [0, size) hold exactly the entities owning all of its types
+template <typename... Cs>
+bool groupHolds(Registry& r) {
+    auto g = r.group<Cs...>();
+    std::size_t owners = 0;
+    for (Entity e : r.alive()) owners += r.has<Cs...>(e);
+    if (owners != g.size()) return false;
+    for (std::size_t i = 0; i < g.size(); ++i)
+        if (!r.has<Cs...>(g.entity(i))) return false;
+    return true;
+}
+
+void restoreUndoesChanges() {
+    Registry r;
+    r.group<Transform, Velocity>();
+    r.group<Transform, Velocity, NetType>();
+    populate(r, 4, 300);
+    const std::uint64_t before = digest(r);
+
+    Registry::Snapshot snap;
+    r.snapshot(snap);
+    CHECK(snap.entities() == r.alive().size());
+    const Entity next = r.create();
+
+    // Destroy half the world, add junk, rename players, then roll back
+    for (std::size_t i = 0; i < r.alive().size(); i += 2) r.destroy(r.alive()[i]);
+    populate(r, 2, 50);
+    r.view<Name>().each([](Name& n) { n.value = "renamed"; });
+    CHECK(digest(r) != before);
+
+    r.restore(snap);
+    CHECK(digest(r) == before);
+    CHECK((groupHolds<Transform, Velocity>(r)));
+    CHECK((groupHolds<Transform, Velocity, NetType>(r)));
+    // Handles come out as they did right after the snapshot
+    CHECK(!r.valid(next));
+    CHECK(r.create() == next);
+
+    // Reusing the snapshot object takes the current state
+    r.snapshot(snap);
+    CHECK(snap.entities() == r.alive().size());
+}
+
+void restoreIntoAnotherRegistry() {
+    Registry source;
+    source.group<Transform, Velocity>();
+    populate(source, 4, 300);
+    const Registry::Snapshot snap = source.snapshot();
+
+    Registry copy; // no groups, no pools yet
+    copy.restore(snap);
+    CHECK(digest(copy) == digest(source));
+    CHECK(copy.storage<Name>().size() == 4);
+    CHECK((groupHolds<Transform, Velocity>(copy)));
+
+    // And back over a registry that has pools the snapshot lacks
+    Registry other;
+    const Entity stray = other.create();
+    other.emplace<BossTag>(stray);
+    other.restore(snap);
+    CHECK(other.storage<BossTag>().empty());
+    CHECK(digest(other) == digest(source));
+}
+
+}
+
+int main() {
+    restoreUndoesChanges();
+    restoreIntoAnotherRegistry();
+    return rt::test::report();
+}
@@ -0,0 +1,115 @@
+#include <cstdint>
+#include <vector>
+#include "Check.hpp"
+#include "rt/timer/TimerWheel.hpp"
+
+using rt::timer::TimerWheel;
+
+namespace {
+
+// Schedules one timer `ticks` out from `start` and checks it fires on exactly
+// that advance()
+void firesOnDueTick(std::uint64_t start, std::uint64_t ticks) {
+    TimerWheel wheel;
+    wheel.clear(start);
+    wheel.scheduleIn(ticks, 7, 3);
+    std::uint64_t firedAt = 0;
+    int fired = 0;
+    while (fired == 0 && wheel.now() < start + ticks + 1)
+        wheel.advance([&](rt::ecs::Entity e, std::uint32_t tag) {
+            CHECK(e == 7 && tag == 3);
+            firedAt = wheel.now();
+            ++fired;
+        });
+    CHECK(fired == 1);
+    CHECK(firedAt == start + ticks);
+    CHECK(wheel.empty());
+}
+
+// Each level boundary, from an aligned clock and from one just short of a
+// level-2 turnover
+void levelBoundaries() {
+    for (std::uint64_t start : {std::uint64_t{0}, std::uint64_t{4093}})
+        for (std::uint64_t ticks : {1ull, 63ull, 64ull, 65ull, 4095ull, 4096ull, 4097ull, 262143ull, 262144ull, 1ull << 24})
+            firesOnDueTick(start, ticks);
+}
+
+// Timers past the top level wait in the overflow list. Walking 2^30 ticks
+// takes seconds, so the clock starts a few ticks before the 2^30 turnover: the
+// due tick then differs from now() above bit 30 and lands in the overflow list
+void overflowList() {
+    constexpr std::uint64_t kTop = std::uint64_t{1} << 30;
+    firesOnDueTick(kTop - 4, 8);
+    firesOnDueTick(3 * kTop - 1, 1);
+    firesOnDueTick(kTop - 4, (1ull << 24) + 8);
+}
+
+void sameTickFifo() {
+    TimerWheel wheel;
+    // Scheduled at different levels, then cascaded into the same slot
+    wheel.schedule(4100, 1);
+    for (int i = 0; i < 4000; ++i) wheel.advance([](auto, auto) {});
+    wheel.schedule(4100, 2);
+    wheel.schedule(4100, 3);
+    for (int i = 0; i < 99; ++i) wheel.advance([](auto, auto) {});
+    wheel.schedule(4100, 4);
+    wheel.schedule(4100, 5);
+    std::vector<rt::ecs::Entity> order;
+    wheel.advance([&](rt::ecs::Entity e, std::uint32_t) { order.push_back(e); });
+    CHECK(wheel.now() == 4100);
+    CHECK((order == std::vector<rt::ecs::Entity>{1, 2, 3, 4, 5}));
+}
+
+void cancelFromCallback() {
+    TimerWheel wheel;
+    const auto a = wheel.scheduleIn(10, 1);
+    const auto b = wheel.scheduleIn(10, 2);
+    wheel.scheduleIn(10, 3);
+    const auto later = wheel.scheduleIn(20, 4);
+    CHECK(wheel.size() == 4);
+    std::vector<rt::ecs::Entity> fired;
+    for (int i = 0; i < 20; ++i)
+        wheel.advance([&](rt::ecs::Entity e, std::uint32_t) {
+            fired.push_back(e);
+            if (e == 1) {
+                CHECK(!wheel.cancel(a));   // already fired
+                CHECK(wheel.cancel(b));    // next on the same chain
+                CHECK(!wheel.cancel(b));
+                CHECK(wheel.cancel(later)); // still in the wheel
+                // May take the node just released; fires on the next tick
+                wheel.scheduleIn(1, 5);
+            }
+        });
+    CHECK((fired == std::vector<rt::ecs::Entity>{1, 3, 5}));
+    CHECK(wheel.empty());
+}
+
+// Ids carry the node generation, so a stale one misses the node's next timer
+void staleIdAfterRecycle() {
+    TimerWheel wheel;
+    const auto first = wheel.scheduleIn(5, 1);
+    CHECK(wheel.cancel(first));
+    const auto second = wheel.scheduleIn(5, 2);
+    CHECK(first != second);
+    CHECK(!wheel.cancel(first));
+    CHECK(wheel.size() == 1);
+
+    int fired = 0;
+    for (int i = 0; i < 5; ++i) wheel.advance([&](auto, auto) { ++fired; });
+    CHECK(fired == 1);
+    const auto third = wheel.scheduleIn(5, 3); // recycles the fired node
+    CHECK(!wheel.cancel(second));
+    CHECK(wheel.cancel(third));
+    CHECK(!wheel.cancel(TimerWheel::kNone));
+}
+
+}
+
+int main() {
+    levelBoundaries();
+    overflowList();
+    sameTickFifo();
+    cancelFromCallback();
+    staleIdAfterRecycle();
+    return rt::test::report();
+}
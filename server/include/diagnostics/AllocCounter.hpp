@@ -0,0 +1,18 @@
+#pragma once
+#include <cstdint>
+
+namespace rtype::server::diagnostics {
+
+#ifdef RTYPE_ALLOC_COUNTER
+inline constexpr bool kCountsAllocations = true;
+#else
+inline constexpr bool kCountsAllocations = false;
+#endif
+
+// Global operator new calls made by the calling thread since it started. With
+// RTYPE_ALLOC_COUNTER the server replaces operator new to count them; diff two
+// reads around a block of code to see whether it touched the heap. Always 0
+// without it.
+std::uint64_t threadAllocations();
+
+} // namespace rtype::server::diagnostics
@@ -1,17 +1,24 @@
 #pragma once
 #include "common/Protocol.hpp"
 #include "gameplay/ThreadSafeRegistry.hpp"
+#include "gameplay/WorldSnapshot.hpp"
 #include "rt/ecs/Registry.hpp"
+#include "rt/jobs/BoundedQueue.hpp"
+#include "rt/jobs/JobSystem.hpp"
+#include "rt/jobs/MpscRing.hpp"
+#include "rt/jobs/RcuBuffer.hpp"
+#include "rt/memory/FrameArena.hpp"
 #include <array>
 #include <asio.hpp>
+#include <atomic>
 #include <chrono>
 #include <functional>
+#include <memory_resource>
 #include <mutex>
 #include <random>
 #include <string>
 #include <thread>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 // Forward declaration to avoid including heavy headers in the interface
@@ -42,35 +49,102 @@ public:
                    std::size_t size);
   void onTcpHello(const std::string &username, const std::string &ip);
 
+  // Slots: the one being written, up to kQueuedFrames + 1 held by the send
+  // stage, the rest for other readers
+  using Snapshots = rt::jobs::RcuBuffer<WorldSnapshot, 6>;
+  // World at the end of the latest tick, for any thread; empty until the
+  // game loop has run once. Holding it does not block the simulation, but
+  // keeps its slot from being reused: drop it when done.
+  Snapshots::Reader latestSnapshot();
+
+  // Time spent per pipeline stage: simulate (inputs to publish, game
+  // thread), stall (game thread waiting for room in the frame queue), send
+  // (packing and sendto, send thread) and latency (publish to last datagram
+  // of a frame)
+  struct StageTiming {
+    std::uint64_t runs = 0;
+    double avgUs = 0.0;
+    double maxUs = 0.0;
+  };
+  struct PipelineStats {
+    StageTiming simulate, stall, send, latency;
+  };
+  // Since the previous call (the stats log calls it when RTYPE_SYSTEM_STATS
+  // is set)
+  PipelineStats takePipelineStats();
+
 private:
   void gameLoop();
+  // Send stage: serializes and fans out the frames queued by gameLoop(), one
+  // frame behind the simulation
+  void sendLoop();
   void checkTimeouts();
   void removeClient(const std::string &key);
-  void broadcastState();
+  void broadcastState(const WorldSnapshot &snap);
   void broadcastDespawn(std::uint32_t entityId);
-  void broadcastRoster();
+  void broadcastRoster(const WorldSnapshot &snap);
   void broadcastLivesUpdate(std::uint32_t id, std::uint8_t lives);
+  void broadcastKills(const std::vector<rtype::net::KillEntry> &kills);
   void broadcastLobbyStatus();
   void maybeStartGame();
 
   void cleanupGameWorld(rt::ecs::Registry &reg);
+  // Fills and publishes the next snapshot (under reg_'s lock); on broadcast
+  // ticks the pending despawns move into it
+  void publishSnapshot(rt::ecs::Registry &reg, bool broadcastTick);
+  // Applies the inputs queued by the I/O thread since the last tick (under
+  // reg_'s lock); the latest record per player wins
+  void applyInputs(rt::ecs::Registry &reg);
+  // Drains the registry's GameEvents once per tick (under reg_'s lock):
+  // lives, score and kill broadcasts, pending despawns
+  void handleEvents(rt::ecs::Registry &reg);
+  void onPlayerHit(rt::ecs::Registry &reg, rt::ecs::Entity e);
+  void onExtraLife(rt::ecs::Registry &reg, rt::ecs::Entity e);
+  void updateTeamScore(rt::ecs::Registry &reg);
 
   static std::string makeKey(const asio::ip::udp::endpoint &ep);
 
+  // Copy of the bound endpoints (under stateMutex_), allocated from mem
+  std::pmr::vector<asio::ip::udp::endpoint>
+  boundEndpoints(std::pmr::memory_resource *mem) const;
+
   void bindUdpEndpoint(const asio::ip::udp::endpoint &ep,
                        std::uint32_t playerId);
 
 private:
+  // Prints registry.systemStats() and starts a new interval
+  static void logSystemStats(rt::ecs::Registry &reg);
+  // Prints the game thread's heap allocations per tick and starts a new
+  // interval
+  void logAllocStats();
+  // Prints the input queue's traffic and starts a new interval
+  void logInputStats();
+  void logPipelineStats();
+
   asio::io_context &io_;
   SendFn send_;
 
   std::thread gameThread_;
+  std::thread sendThread_;
   bool running_ = false;
 
   // Tick-synchronized state broadcasting
   std::uint32_t tickCount_ = 0;
   static constexpr std::uint32_t kBroadcastEveryNTicks =
       3; // 60Hz / 3 = 20Hz state updates
+  // Per-system timings are logged every N ticks (RTYPE_SYSTEM_STATS seconds,
+  // unset or 0 = off)
+  std::uint32_t statsEveryNTicks_ = 0;
+
+  // Scratch memory of the tick in progress, reset when the tick ends; only
+  // the game thread allocates from it
+  rt::memory::FrameArena frameArena_;
+  // Same for the send thread, reset after each frame
+  rt::memory::FrameArena sendArena_;
+  // Heap allocations of the game thread per tick, since the last stats log
+  std::uint64_t tickAllocsTotal_ = 0;
+  std::uint64_t tickAllocsMax_ = 0;
+  std::uint32_t tickAllocsTicks_ = 0;
 
   // Mutex for protecting shared state accessed by both I/O and game loop
   // threads Lock ordering: Always acquire stateMutex_ before any operations on
@@ -91,12 +165,56 @@ private:
   std::uint8_t lobbyDifficulty_ = 1;
   std::uint8_t nextShipId_ = 0; // 0..4 repeating
 
+  // Workers for the system scheduler; declared first so it outlives reg_
+  rt::jobs::JobSystem jobs_;
   // ECS Registry (separate synchronization if needed)
   ThreadSafeRegistry reg_;
   std::mt19937 rng_;
-  std::unordered_set<std::uint32_t>
-      lastKnownEntityIds_; // Track entities from previous tick to detect
-                           // deletions
+  std::vector<std::uint32_t>
+      despawned_; // NetType entities destroyed since the last broadcast tick
+  // Published at the end of every tick by the game thread
+  Snapshots snapshots_;
+  // Set by whoever changes the bound players; the game thread sends the
+  // roster from the next snapshot
+  std::atomic<bool> rosterDirty_{false};
+
+  // A published frame handed to the send stage
+  struct SendFrame {
+    Snapshots::Reader snap;
+    bool state = false;  // despawns and State datagrams
+    bool roster = false; // Roster datagram
+    std::chrono::steady_clock::time_point published{};
+  };
+  // Two broadcast intervals of slack; beyond that the game thread waits
+  static constexpr std::size_t kQueuedFrames = 2;
+  rt::jobs::BoundedQueue<SendFrame> frames_{kQueuedFrames};
+
+  // Run times of one stage, recorded by its thread, read by the stats log
+  struct StageClock {
+    std::atomic<std::uint64_t> runs{0};
+    std::atomic<std::uint64_t> totalNs{0};
+    std::atomic<std::uint64_t> maxNs{0};
+    void record(std::chrono::steady_clock::duration d);
+    StageTiming take();
+  };
+  StageClock simulateClock_, stallClock_, sendClock_, latencyClock_;
+
+  // One Input datagram, queued by the I/O thread for the next tick
+  struct InputRecord {
+    std::uint32_t playerId = 0;
+    std::uint32_t sequence = 0;
+    std::uint8_t bits = 0;
+    std::chrono::steady_clock::time_point recvTime{};
+  };
+  // Input handoff without reg_'s lock: the I/O thread pushes, the game thread
+  // drains at the start of every tick. Full ring: the datagram is dropped,
+  // the next one carries the same held keys.
+  rt::jobs::MpscRing<InputRecord> inputs_{1024};
+  std::atomic<std::uint64_t> inputsDropped_{0};
+  // Game thread only, since the last stats log
+  std::uint64_t inputsApplied_ = 0;
+  std::chrono::steady_clock::duration inputWaitMax_{};
+  std::vector<rtype::net::KillEntry> kills_; // reused by handleEvents
 
   // Ping/Pong
   std::chrono::steady_clock::time_point lastPingTime_;
@@ -0,0 +1,29 @@
+#pragma once
+#include "common/Protocol.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace rtype::server::gameplay {
+
+// What the world looked like at the end of one tick, published by the game
+// thread. Readers (snapshot and roster broadcasts, metrics, spectators or
+// replays) take it from GameSession::latestSnapshot() and never touch the
+// live registry. Vectors are refilled in place, so they keep their capacity.
+struct WorldSnapshot {
+  std::uint32_t tick = 0;
+  // Replicated entities in wire form, split by kind, in registry order
+  std::vector<rtype::net::PackedEntity> players;
+  std::vector<rtype::net::PackedEntity> enemies;
+  std::vector<rtype::net::PackedEntity> bullets;
+  std::vector<rtype::net::PackedEntity> powerups;
+  // NetType entities destroyed since the last broadcast tick, players included
+  std::vector<std::uint32_t> despawned;
+  // Bound players, in endpoint map order, as sent in Roster
+  std::vector<rtype::net::PlayerEntry> roster;
+  // Session state
+  std::uint32_t hostId = 0;
+  bool started = false;
+  std::int32_t teamScore = 0;
+};
+
+} // namespace rtype::server::gameplay
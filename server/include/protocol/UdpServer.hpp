@@ -3,6 +3,7 @@
 #include <array>
 #include <functional>
 #include <memory>
+#include <mutex>
 
 namespace rtype::server {
 
@@ -28,6 +29,9 @@ private:
     asio::ip::udp::socket socket_;
     std::array<char, 2048> buffer_{};
     asio::ip::udp::endpoint remote_;
+    // sendRaw() is called from the io, game and send threads; one send (or
+    // the close in stop()) touches the socket at a time
+    std::mutex sendMutex_;
     bool running_ = false;
 
     PacketHandler handler_{};
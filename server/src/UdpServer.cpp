@@ -24,6 +24,7 @@ void UdpServer::start() {
 
 void UdpServer::stop() {
     running_ = false;
+    std::lock_guard<std::mutex> lock(sendMutex_);
     if (socket_.is_open()) {
         asio::error_code ec; socket_.close(ec);
     }
@@ -41,7 +42,11 @@ void UdpServer::doReceive() {
     );
 }
 
+// Synchronous: a UDP send only queues the datagram in the kernel, and the
+// caller's buffer can stay where it is (no copy, no handler allocation).
+// Callers on different threads take turns on the socket.
 void UdpServer::sendRaw(const asio::ip::udp::endpoint& to, const void* data, std::size_t size) {
-    auto buf = std::make_shared<std::vector<char>>(static_cast<const char*>(data), static_cast<const char*>(data) + size);
-    socket_.async_send_to(asio::buffer(*buf), to, [buf](std::error_code, std::size_t) {});
+    std::lock_guard<std::mutex> lock(sendMutex_);
+    asio::error_code ec;
+    socket_.send_to(asio::buffer(data, size), to, 0, ec);
 }
@@ -0,0 +1,79 @@
+#include "diagnostics/AllocCounter.hpp"
+
+#ifdef RTYPE_ALLOC_COUNTER
+#include <cstdlib>
+#include <new>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace {
+#ifdef _WIN32
+void *alignedMalloc(std::size_t a, std::size_t size) {
+  return _aligned_malloc(size, a);
+}
+void alignedFree(void *p) { _aligned_free(p); }
+#else
+void *alignedMalloc(std::size_t a, std::size_t size) {
+  return std::aligned_alloc(a, size);
+}
+void alignedFree(void *p) { std::free(p); }
+#endif
+
+// Plain thread_local integer: no constructor, so counting works from the very
+// first allocation of every thread
+thread_local std::uint64_t tlsAllocations = 0;
+
+void *allocate(std::size_t size) {
+  ++tlsAllocations;
+  if (size == 0)
+    size = 1;
+  while (true) {
+    if (void *p = std::malloc(size))
+      return p;
+    if (auto handler = std::get_new_handler())
+      handler();
+    else
+      throw std::bad_alloc();
+  }
+}
+
+void *allocateAligned(std::size_t size, std::align_val_t align) {
+  ++tlsAllocations;
+  const auto a = static_cast<std::size_t>(align);
+  // aligned_alloc wants a multiple of the alignment
+  size = (size + a - 1) / a * a;
+  if (size == 0)
+    size = a;
+  while (true) {
+    if (void *p = alignedMalloc(a, size))
+      return p;
+    if (auto handler = std::get_new_handler())
+      handler();
+    else
+      throw std::bad_alloc();
+  }
+}
+} // namespace
+
+std::uint64_t rtype::server::diagnostics::threadAllocations() {
+  return tlsAllocations;
+}
+
+// The array and nothrow forms forward to these by default
+void *operator new(std::size_t size) { return allocate(size); }
+void *operator new(std::size_t size, std::align_val_t align) {
+  return allocateAligned(size, align);
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept {
+  alignedFree(p);
+}
+
+#else
+
+std::uint64_t rtype::server::diagnostics::threadAllocations() { return 0; }
+
+#endif
@@ -1,12 +1,21 @@
 #include "gameplay/GameSession.hpp"
+#include "diagnostics/AllocCounter.hpp"
 #include "protocol/TcpServer.hpp"
 #include "rt/game/Components.hpp"
 #include "rt/game/Systems.hpp"
+#include "rt/reflect/Binary.hpp"
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <thread>
+#include <variant>
 
 using namespace rtype::server::gameplay;
 using rtype::server::TcpServer;
@@ -15,15 +24,102 @@ static std::string makeKeyLocal(const asio::ip::udp::endpoint &ep) {
   return ep.address().to_string() + ":" + std::to_string(ep.port());
 }
 
+namespace {
+// The frame arena on the game thread, unset elsewhere: helpers shared with the
+// I/O thread take their scratch buffers from the tick being run, or the heap
+thread_local std::pmr::memory_resource *tlsScratch = nullptr;
+
+std::pmr::memory_resource *scratch() {
+  return tlsScratch ? tlsScratch : std::pmr::get_default_resource();
+}
+} // namespace
+
 GameSession::GameSession(asio::io_context &io, SendFn sendFn,
                          TcpServer *tcpServer)
     : io_(io), send_(std::move(sendFn)), rng_(std::random_device{}()),
-      lastPingTime_(std::chrono::steady_clock::now()), tcp_(tcpServer) {}
+      lastPingTime_(std::chrono::steady_clock::now()), tcp_(tcpServer) {
+  if (const char *v = std::getenv("RTYPE_SYSTEM_STATS"))
+    statsEveryNTicks_ = static_cast<std::uint32_t>(std::atoi(v)) * 60; // 60 Hz
+  // Despawns come through the event ring and go out with the next snapshot
+  reg_.withLock([&](auto &reg) { rt::game::trackDespawns(reg); });
+}
 
 GameSession::~GameSession() { stop(); }
 
+void GameSession::logSystemStats(rt::ecs::Registry &reg) {
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(1);
+  out << "[server] System stats (us p50/p99/max, per run: processed "
+         "created destroyed)\n";
+  for (const auto &s : reg.systemStats()) {
+    if (s.runs == 0)
+      continue;
+    const auto perRun = [&](std::uint64_t v) {
+      return static_cast<double>(v) / static_cast<double>(s.runs);
+    };
+    out << "  " << std::left << std::setw(26) << s.name << std::right
+        << std::setw(8) << s.p50Us << std::setw(8) << s.p99Us << std::setw(8)
+        << s.maxUs << std::setw(10) << perRun(s.processed) << std::setw(7)
+        << perRun(s.created) << std::setw(7) << perRun(s.destroyed) << '\n';
+  }
+  std::cout << out.str() << std::flush;
+  reg.resetSystemStats();
+}
+
+void GameSession::logAllocStats() {
+  if (tickAllocsTicks_ == 0)
+    return;
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(2);
+  if (diagnostics::kCountsAllocations)
+    out << "[server] Heap allocations per tick: avg "
+        << static_cast<double>(tickAllocsTotal_) /
+               static_cast<double>(tickAllocsTicks_)
+        << " max " << tickAllocsMax_ << " (frame arena "
+        << frameArena_.capacity() << " B, peak " << frameArena_.peak()
+        << " B)\n";
+  else
+    out << "[server] Frame arena " << frameArena_.capacity() << " B, peak "
+        << frameArena_.peak() << " B (heap allocations not counted)\n";
+  std::cout << out.str() << std::flush;
+  tickAllocsTotal_ = 0;
+  tickAllocsMax_ = 0;
+  tickAllocsTicks_ = 0;
+}
+
+void GameSession::logPipelineStats() {
+  const PipelineStats st = takePipelineStats();
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(1);
+  out << "[server] Pipeline stages (us avg/max, runs)\n";
+  const auto row = [&](const char *name, const StageTiming &t) {
+    out << "  " << std::left << std::setw(10) << name << std::right
+        << std::setw(8) << t.avgUs << std::setw(8) << t.maxUs << std::setw(8)
+        << t.runs << '\n';
+  };
+  row("simulate", st.simulate);
+  row("stall", st.stall);
+  row("send", st.send);
+  row("latency", st.latency);
+  std::cout << out.str() << std::flush;
+}
+
+void GameSession::logInputStats() {
+  using us = std::chrono::duration<double, std::micro>;
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(1);
+  out << "[server] Inputs: " << inputsApplied_ << " applied, "
+      << inputsDropped_.exchange(0, std::memory_order_relaxed)
+      << " dropped (queue full), max wait " << us(inputWaitMax_).count()
+      << " us\n";
+  std::cout << out.str() << std::flush;
+  inputsApplied_ = 0;
+  inputWaitMax_ = {};
+}
+
 void GameSession::start() {
   running_ = true;
+  sendThread_ = std::thread([this] { sendLoop(); });
   gameThread_ = std::thread([this] { gameLoop(); });
 }
 
@@ -31,6 +127,10 @@ void GameSession::stop() {
   running_ = false;
   if (gameThread_.joinable())
     gameThread_.join();
+  // The send stage flushes what the last ticks queued, then exits
+  frames_.close();
+  if (sendThread_.joinable())
+    sendThread_.join();
 }
 
 void GameSession::onTcpHello(const std::string &username,
@@ -114,8 +214,8 @@ void GameSession::bindUdpEndpoint(const asio::ip::udp::endpoint &ep,
     keyToEndpoint_[key] = ep;
     lastSeen_[key] = std::chrono::steady_clock::now();
   }
-  // Broadcast outside the lock to avoid blocking I/O while holding the mutex
-  broadcastRoster();
+  // The game thread sends the roster once the next snapshot has the player
+  rosterDirty_.store(true, std::memory_order_release);
   broadcastLobbyStatus();
   std::cout << "[server] Player UDP bound: id=" << playerId << " from "
             << ep.address().to_string() << ":" << ep.port() << std::endl;
@@ -124,17 +224,28 @@ void GameSession::bindUdpEndpoint(const asio::ip::udp::endpoint &ep,
 void GameSession::onUdpPacket(const asio::ip::udp::endpoint &from,
                               const char *data, std::size_t size) {
   auto key = makeKey(from);
-
-  // If endpoint not bound, check for pending player from TCP
+  const auto now = std::chrono::steady_clock::now();
+  const bool valid =
+      size >= sizeof(rtype::net::Header) &&
+      reinterpret_cast<const rtype::net::Header *>(data)->version ==
+          rtype::net::ProtocolVersion;
+
+  // One short stateMutex_ section for the binding and lastSeen_; if the
+  // endpoint is not bound, check for a pending player from TCP
   bool needsBind = false;
-  std::uint32_t playerIdToBind = 0;
+  std::uint32_t playerId = 0;
   {
     std::lock_guard<std::mutex> lock(stateMutex_);
-    if (endpointToPlayerId_.find(key) == endpointToPlayerId_.end()) {
+    auto bound = endpointToPlayerId_.find(key);
+    if (bound != endpointToPlayerId_.end()) {
+      playerId = bound->second;
+      if (valid)
+        lastSeen_[key] = now;
+    } else {
       auto ip = from.address().to_string();
       auto it = pendingByIp_.find(ip);
       if (it != pendingByIp_.end()) {
-        playerIdToBind = it->second;
+        playerId = it->second;
         pendingByIp_.erase(it);
         needsBind = true;
       } else {
@@ -144,43 +255,24 @@ void GameSession::onUdpPacket(const asio::ip::udp::endpoint &from,
   }
 
   if (needsBind) {
-    bindUdpEndpoint(from, playerIdToBind);
+    bindUdpEndpoint(from, playerId);
   }
 
-  if (size < sizeof(rtype::net::Header))
+  if (!valid)
     return;
   const auto *header = reinterpret_cast<const rtype::net::Header *>(data);
-  if (header->version != rtype::net::ProtocolVersion)
-    return;
-
-  {
-    std::lock_guard<std::mutex> lock(stateMutex_);
-    lastSeen_[key] = std::chrono::steady_clock::now();
-  }
 
   const char *payload = data + sizeof(rtype::net::Header);
   std::size_t payloadSize = size - sizeof(rtype::net::Header);
 
+  // Inputs never wait for the tick: they are queued for the game thread,
+  // which applies them before its next update
   if (header->type == rtype::net::MsgType::Input) {
     if (payloadSize >= sizeof(rtype::net::InputPacket)) {
-      auto *in = reinterpret_cast<const rtype::net::InputPacket *>(payload);
-      std::uint32_t playerId = 0;
-      bool found = false;
-      {
-        std::lock_guard<std::mutex> lock(stateMutex_);
-        auto it = endpointToPlayerId_.find(key);
-        if (it != endpointToPlayerId_.end()) {
-          playerId = it->second;
-          found = true;
-        }
-      }
-      if (found) {
-        reg_.withLock([&](auto &reg) {
-          if (auto *pi = reg.template get<rt::game::PlayerInput>(playerId)) {
-            pi->bits = in->bits;
-          }
-        });
-      }
+      rtype::net::InputPacket in;
+      std::memcpy(&in, payload, sizeof(in));
+      if (!inputs_.tryPush({playerId, in.sequence, in.bits, now}))
+        inputsDropped_.fetch_add(1, std::memory_order_relaxed);
     }
     return;
   }
@@ -258,23 +350,21 @@ void GameSession::onUdpPacket(const asio::ip::udp::endpoint &from,
           if (auto *sc = reg.template get<rt::game::Score>(pid)) {
             sc->value = 0;
           }
-          if (auto *inv = reg.template get<rt::game::Invincible>(pid)) {
-            inv->timeLeft = 1.0f;
-          } else {
-            reg.template emplace<rt::game::Invincible>(
-                pid, rt::game::Invincible{1.0f});
-          }
+          // Exactly 1 s, even if a longer shield was running
+          reg.template remove<rt::game::Invincible>(pid);
+          rt::game::grantInvincible(reg, pid, 1.0f);
           playerIndex++;
         }
 
         cleanupGameWorld(reg);
-        lastKnownEntityIds_.clear();
+        despawned_.clear();
+        reg.template ctx<rt::game::GameEvents>().clear();
       });
 
       std::cout << "[server] Game initialized for " << playerIds.size()
                 << " players\n";
 
-      broadcastRoster();
+      rosterDirty_.store(true, std::memory_order_release);
       broadcastLobbyStatus();
 
       // Send initial score update
@@ -283,19 +373,12 @@ void GameSession::onUdpPacket(const asio::ip::udp::endpoint &from,
       scoreHdr.type = rtype::net::MsgType::ScoreUpdate;
       scoreHdr.size = sizeof(rtype::net::ScoreUpdatePayload);
       rtype::net::ScoreUpdatePayload scorePayload{0, 0};
-      std::vector<char> scoreOut(sizeof(scoreHdr) + sizeof(scorePayload));
+      std::array<char, sizeof(scoreHdr) + sizeof(scorePayload)> scoreOut;
       std::memcpy(scoreOut.data(), &scoreHdr, sizeof(scoreHdr));
       std::memcpy(scoreOut.data() + sizeof(scoreHdr), &scorePayload,
                   sizeof(scorePayload));
 
-      std::vector<asio::ip::udp::endpoint> endpoints;
-      {
-        std::lock_guard<std::mutex> lock(stateMutex_);
-        for (const auto &[_, ep] : keyToEndpoint_) {
-          endpoints.push_back(ep);
-        }
-      }
-      for (const auto &ep : endpoints) {
+      for (const auto &ep : boundEndpoints(scratch())) {
         send_(ep, scoreOut.data(), scoreOut.size());
       }
     }
@@ -314,29 +397,44 @@ void GameSession::gameLoop() {
   const double dt = 1.0 / tickRate;
   auto next = clock::now();
   float elapsed = 0.f;
+  tlsScratch = &frameArena_;
 
   reg_.withLock([&](auto &reg) {
+    // Systems with disjoint declared access run side by side on jobs_
+    reg.setJobs(&jobs_);
+    // Owning groups for the hottest joins (movement, snapshots); nested, so
+    // they share the Transform/Velocity pools
+    reg.template group<rt::game::Transform, rt::game::Velocity>();
+    reg.template group<rt::game::Transform, rt::game::Velocity,
+                       rt::game::NetType, rt::game::ColorRGBA>();
     reg.template addSystem(std::make_unique<rt::game::InputSystem>());
     reg.template addSystem(std::make_unique<rt::game::ShootingSystem>());
     reg.template addSystem(std::make_unique<rt::game::ChargeShootingSystem>());
     reg.template addSystem(
         std::make_unique<rt::game::FormationSystem>(&elapsed));
     reg.template addSystem(std::make_unique<rt::game::MovementSystem>());
+    reg.template addSystem(std::make_unique<rt::game::SpatialIndexSystem>());
     reg.template addSystem(
         std::make_unique<rt::game::EnemyShootingSystem>(rng_));
+    // Off-screen enemies are harmless for a few frames: sweep a quarter of
+    // them per tick
     reg.template addSystem(
-        std::make_unique<rt::game::DespawnOffscreenSystem>(-50.f));
+        std::make_unique<rt::game::DespawnOffscreenSystem>(-50.f),
+        rt::ecs::Schedule{1, 4});
     reg.template addSystem(std::make_unique<rt::game::DespawnOutOfBoundsSystem>(
         -50.f, 1000.f, -50.f, 600.f));
     reg.template addSystem(std::make_unique<rt::game::CollisionSystem>());
     reg.template addSystem(std::make_unique<rt::game::InvincibilitySystem>());
+    // Spawners only poll a score or a timer: 10-20 Hz is plenty
     reg.template addSystem(
-        std::make_unique<rt::game::PowerupSpawnSystem>(rng_, &lastTeamScore_));
+        std::make_unique<rt::game::PowerupSpawnSystem>(rng_, &lastTeamScore_),
+        rt::ecs::Schedule{6});
     reg.template addSystem(
         std::make_unique<rt::game::PowerupCollisionSystem>());
     reg.template addSystem(std::make_unique<rt::game::InfiniteFireSystem>());
     reg.template addSystem(
-        std::make_unique<rt::game::FormationSpawnSystem>(rng_, &elapsed));
+        std::make_unique<rt::game::FormationSpawnSystem>(rng_, &elapsed),
+        rt::ecs::Schedule{3, 1, 1});
   });
 
   while (running_) {
@@ -344,9 +442,11 @@ void GameSession::gameLoop() {
         std::chrono::duration<double>(dt));
     elapsed += static_cast<float>(dt);
     tickCount_++;
+    const std::uint64_t allocsBefore = diagnostics::threadAllocations();
 
     // Ping mechanism (every 1 second)
     auto now = clock::now();
+    const auto tickStart = now;
     if (now - lastPingTime_ >= std::chrono::seconds(1)) {
       lastPingTime_ = now;
       rtype::net::Header ph{};
@@ -354,13 +454,7 @@ void GameSession::gameLoop() {
       ph.type = rtype::net::MsgType::Ping;
       ph.size = 0;
 
-      std::vector<asio::ip::udp::endpoint> eps;
-      {
-        std::lock_guard<std::mutex> lock(stateMutex_);
-        for (auto &[_, ep] : keyToEndpoint_)
-          eps.push_back(ep);
-      }
-      for (auto &ep : eps)
+      for (auto &ep : boundEndpoints(&frameArena_))
         send_(ep, &ph, sizeof(ph));
     }
 
@@ -370,110 +464,17 @@ void GameSession::gameLoop() {
       isGameStarted = gameStarted_;
     }
 
-    // Only run game systems if the match has started
-    if (isGameStarted) {
-      reg_.withLock([&](auto &reg) {
+    // Only run game systems if the match has started; inputs are taken in
+    // every tick so the queue never backs up in the lobby
+    reg_.withLock([&](auto &reg) {
+      applyInputs(reg);
+      if (isGameStarted)
         reg.update(static_cast<float>(dt));
+    });
 
-        for (auto &[e, inp] :
-             reg.template storage<rt::game::PlayerInput>().data()) {
-          (void)inp;
-          if (auto *hf = reg.template get<rt::game::HitFlag>(e)) {
-            if (hf->value) {
-              std::uint8_t lives = 0;
-              if (auto *l = reg.template get<rt::game::Lives>(e)) {
-                if (l->value > 0) {
-                  l->value--;
-                  lives = l->value;
-                }
-              }
-              if (lives > 0 || lives == 0) { // Keep logic
-                broadcastLivesUpdate(e, lives);
-              }
-              if (auto *t = reg.template get<rt::game::Transform>(e)) {
-                constexpr float kStartX = 50.f;
-                constexpr float kWorldH = 600.f;
-                constexpr float kTopMargin = 56.f;
-                constexpr float kBottomMargin = 10.f;
-                float y = t->y;
-                float maxY = kWorldH - kBottomMargin - 12.f;
-                if (y < kTopMargin)
-                  y = kTopMargin;
-                if (y > maxY)
-                  y = maxY;
-                t->x = kStartX;
-                t->y = y;
-              }
-              if (auto *v = reg.template get<rt::game::Velocity>(e)) {
-                v->vx = 0.f;
-                v->vy = 0.f;
-              }
-              if (auto *inv = reg.template get<rt::game::Invincible>(e)) {
-                inv->timeLeft = std::max(inv->timeLeft, 1.0f);
-              } else {
-                reg.template emplace<rt::game::Invincible>(
-                    e, rt::game::Invincible{1.0f});
-              }
-              hf->value = false;
-            } // This closes 'if (hf->value)'
-          }
-
-          // Handle life pickups
-          if (auto *lp = reg.template get<rt::game::LifePickup>(e)) {
-            if (lp->pending) {
-              std::uint8_t lives = 0;
-              if (auto *l = reg.template get<rt::game::Lives>(e)) {
-                lives = l->value;
-                if (lives < 10) {
-                  lives++;
-                  l->value = lives;
-                }
-              }
-              broadcastLivesUpdate(e, lives);
-              lp->pending = false; // Mark as processed
-            }
-          }
-        }
-
-        std::int32_t teamScore = 0;
-        for (auto &[e, inp] :
-             reg.template storage<rt::game::PlayerInput>().data()) {
-          (void)inp;
-          if (auto *sc = reg.template get<rt::game::Score>(e)) {
-            std::lock_guard<std::mutex> lock(stateMutex_);
-            // playerScores_[e] = sc->value; // Removed
-            teamScore += sc->value;
-          }
-        }
-
-        bool shouldBroadcastScore = false;
-        std::vector<asio::ip::udp::endpoint> endpoints;
-        {
-          std::lock_guard<std::mutex> lock(stateMutex_);
-          if (teamScore != lastTeamScore_) {
-            lastTeamScore_ = teamScore;
-            shouldBroadcastScore = true;
-            for (const auto &[_, ep] : keyToEndpoint_) {
-              endpoints.push_back(ep);
-            }
-          }
-        }
-
-        if (shouldBroadcastScore) {
-          rtype::net::Header hdr{};
-          hdr.version = rtype::net::ProtocolVersion;
-          hdr.type = rtype::net::MsgType::ScoreUpdate;
-          hdr.size = sizeof(rtype::net::ScoreUpdatePayload);
-          rtype::net::ScoreUpdatePayload p{0, teamScore};
-          std::vector<char> out(sizeof(hdr) + sizeof(p));
-          std::memcpy(out.data(), &hdr, sizeof(hdr));
-          std::memcpy(out.data() + sizeof(hdr), &p, sizeof(p));
-          for (const auto &ep : endpoints) {
-            send_(ep, out.data(), out.size());
-          }
-        }
-      });
-    }
+    // What the systems reported this tick, and entities destroyed outside
+    // update() since the last one
+    reg_.withLock([&](auto &reg) { handleEvents(reg); });
 
     checkTimeouts();
 
@@ -481,42 +482,102 @@ void GameSession::gameLoop() {
     // state snapshots are always aligned with completed game tick
     // boundaries. This eliminates desync between game logic and network
     // updates.
-    if (tickCount_ % kBroadcastEveryNTicks == 0) {
-      // Detect destroyed entities by comparing before/after entity sets
-      std::unordered_set<std::uint32_t> currentEntityIds;
-      std::unordered_set<std::uint32_t> playerIds;
-      {
-        std::lock_guard<std::mutex> lock(stateMutex_);
-        for (const auto &[_, pid] : endpointToPlayerId_) {
-          playerIds.insert(pid);
-        }
+    const bool broadcastTick = tickCount_ % kBroadcastEveryNTicks == 0;
+    // The last registry access of the tick; everything below reads the
+    // snapshot
+    reg_.withLock([&](auto &reg) { publishSnapshot(reg, broadcastTick); });
+    const auto published = clock::now();
+    simulateClock_.record(published - tickStart);
+
+    // Serialization and sendto run on the send thread while the next tick
+    // simulates; a full queue holds this thread back
+    const bool roster = rosterDirty_.exchange(false, std::memory_order_acq_rel);
+    if (broadcastTick || roster) {
+      SendFrame frame{latestSnapshot(), broadcastTick, roster, published};
+      if (frame.snap) {
+        frames_.push(std::move(frame));
+        stallClock_.record(clock::now() - published);
       }
-      // Access storage under lock
-      reg_.withLock([&](auto &reg) {
-        for (auto &[e, nt] : reg.template storage<rt::game::NetType>().data()) {
-          currentEntityIds.insert(e);
-        }
-      });
-      // Send Despawn for entities that disappeared (excluding players)
-      for (std::uint32_t id : lastKnownEntityIds_) {
-        if (currentEntityIds.find(id) == currentEntityIds.end() &&
-            playerIds.find(id) == playerIds.end()) {
-          broadcastDespawn(id);
-        }
+    }
+
+    // Everything the tick allocated goes at once; a tick that needed more
+    // than the arena holds grows it for the next one
+    frameArena_.reset();
+    if (isGameStarted) {
+      const std::uint64_t allocs =
+          diagnostics::threadAllocations() - allocsBefore;
+      tickAllocsTotal_ += allocs;
+      tickAllocsMax_ = std::max(tickAllocsMax_, allocs);
+      tickAllocsTicks_++;
+      // Logged after the count: the report itself allocates
+      if (statsEveryNTicks_ && tickCount_ % statsEveryNTicks_ == 0) {
+        reg_.withLock([&](auto &reg) { logSystemStats(reg); });
+        logAllocStats();
+        logInputStats();
+        logPipelineStats();
       }
-      lastKnownEntityIds_ = currentEntityIds;
-      broadcastState();
     }
 
     std::this_thread::sleep_until(next);
   }
 }
 
+void GameSession::sendLoop() {
+  using clock = std::chrono::steady_clock;
+  tlsScratch = &sendArena_;
+  SendFrame frame;
+  while (frames_.pop(frame)) {
+    const auto start = clock::now();
+    const WorldSnapshot &snap = *frame.snap;
+    if (frame.roster)
+      broadcastRoster(snap);
+    if (frame.state) {
+      // Entities destroyed since the last broadcast, players included
+      for (std::uint32_t id : snap.despawned) {
+        broadcastDespawn(id);
+      }
+      broadcastState(snap);
+    }
+    frame.snap = {}; // frees the slot for the game thread
+    sendArena_.reset();
+    const auto end = clock::now();
+    sendClock_.record(end - start);
+    latencyClock_.record(end - frame.published);
+  }
+}
+
+void GameSession::StageClock::record(std::chrono::steady_clock::duration d) {
+  const auto ns = static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+  runs.fetch_add(1, std::memory_order_relaxed);
+  totalNs.fetch_add(ns, std::memory_order_relaxed);
+  auto prev = maxNs.load(std::memory_order_relaxed);
+  while (prev < ns &&
+         !maxNs.compare_exchange_weak(prev, ns, std::memory_order_relaxed)) {
+  }
+}
+
+GameSession::StageTiming GameSession::StageClock::take() {
+  StageTiming t;
+  t.runs = runs.exchange(0, std::memory_order_relaxed);
+  const auto total = totalNs.exchange(0, std::memory_order_relaxed);
+  t.maxUs =
+      static_cast<double>(maxNs.exchange(0, std::memory_order_relaxed)) / 1e3;
+  if (t.runs)
+    t.avgUs = static_cast<double>(total) / 1e3 / static_cast<double>(t.runs);
+  return t;
+}
+
+GameSession::PipelineStats GameSession::takePipelineStats() {
+  return {simulateClock_.take(), stallClock_.take(), sendClock_.take(),
+          latencyClock_.take()};
+}
+
 void GameSession::checkTimeouts() {
   using namespace std::chrono;
   const auto now = steady_clock::now();
   const auto timeout = seconds(10);
-  std::vector<std::string> toRemove;
+  std::pmr::vector<std::string> toRemove(scratch());
   {
     std::lock_guard<std::mutex> lock(stateMutex_);
     for (auto &[key, last] : lastSeen_) {
@@ -531,7 +592,7 @@ void GameSession::checkTimeouts() {
 void GameSession::removeClient(const std::string &key) {
   std::uint32_t id = 0;
   bool wasHost = false;
-  std::vector<asio::ip::udp::endpoint> endpoints;
+  std::pmr::vector<asio::ip::udp::endpoint> endpoints(scratch());
   bool shouldStopGame = false;
   bool allPlayersLeft = false;
 
@@ -580,17 +641,8 @@ void GameSession::removeClient(const std::string &key) {
     }
   });
 
-  // Send despawn message
-  rtype::net::Header hdr{};
-  hdr.size = sizeof(std::uint32_t);
-  hdr.type = rtype::net::MsgType::Despawn;
-  hdr.version = rtype::net::ProtocolVersion;
-  std::vector<char> out(sizeof(hdr) + sizeof(std::uint32_t));
-  std::memcpy(out.data(), &hdr, sizeof(hdr));
-  std::memcpy(out.data() + sizeof(hdr), &id, sizeof(id));
-  for (auto &ep : endpoints) {
-    send_(ep, out.data(), out.size());
-  }
+  // The Despawn goes out from the send stage with the first snapshot that no
+  // longer has the player, so queued frames cannot bring it back on clients
 
   std::cout << "[server] Removed disconnected client: " << key << " (id=" << id
             << ")\n";
@@ -600,7 +652,7 @@ void GameSession::removeClient(const std::string &key) {
     std::cout << "[server] All players left. Game world cleaned up.\n";
   }
 
-  broadcastRoster();
+  rosterDirty_.store(true, std::memory_order_release);
   broadcastLobbyStatus();
 
   // If game was running and not enough players remain, stop the game
@@ -621,23 +673,90 @@ void GameSession::broadcastDespawn(std::uint32_t entityId) {
   hdr.size = sizeof(std::uint32_t);
   hdr.type = rtype::net::MsgType::Despawn;
   hdr.version = rtype::net::ProtocolVersion;
-  std::vector<char> out(sizeof(hdr) + sizeof(std::uint32_t));
+  std::array<char, sizeof(hdr) + sizeof(std::uint32_t)> out;
   std::memcpy(out.data(), &hdr, sizeof(hdr));
   std::memcpy(out.data() + sizeof(hdr), &entityId, sizeof(entityId));
 
-  std::vector<asio::ip::udp::endpoint> endpoints;
+  for (const auto &ep : boundEndpoints(scratch())) {
+    send_(ep, out.data(), out.size());
+  }
+}
+
+void GameSession::publishSnapshot(rt::ecs::Registry &reg, bool broadcastTick) {
+  static_assert(rt::reflect::wireSizeOf<rt::ecs::Entity, rt::game::NetType,
+                                        rt::game::Transform, rt::game::Velocity,
+                                        rt::game::ColorRGBA> ==
+                    sizeof(rtype::net::PackedEntity),
+                "PackedEntity no longer matches the replicated components");
+  WorldSnapshot *snap = snapshots_.beginWrite();
+  if (!snap)
+    return; // every other slot is being read; keep the previous one
+  snap->tick = tickCount_;
+  snap->players.clear();
+  snap->enemies.clear();
+  snap->bullets.clear();
+  snap->powerups.clear();
+  reg.group<const rt::game::NetType, const rt::game::Transform,
+            const rt::game::Velocity, const rt::game::ColorRGBA>()
+      .each([&](rt::ecs::Entity e, const rt::game::NetType &nt,
+                const rt::game::Transform &tr, const rt::game::Velocity &ve,
+                const rt::game::ColorRGBA &co) {
+        // id, then the reflected fields of each component, in wire order
+        rtype::net::PackedEntity pe;
+        rt::reflect::write(reinterpret_cast<std::byte *>(&pe), e, nt, tr, ve,
+                           co);
+        switch (nt.type) {
+        case rtype::net::EntityType::Player:
+          snap->players.push_back(pe);
+          break;
+        case rtype::net::EntityType::Bullet:
+          snap->bullets.push_back(pe);
+          break;
+        case rtype::net::EntityType::Powerup:
+          snap->powerups.push_back(pe);
+          break;
+        case rtype::net::EntityType::Enemy:
+        default:
+          snap->enemies.push_back(pe);
+          break;
+        }
+      });
+
+  // Despawns pile up until the tick that sends them
+  snap->despawned.assign(despawned_.begin(), despawned_.end());
+  if (broadcastTick)
+    despawned_.clear();
+
+  snap->roster.clear();
   {
     std::lock_guard<std::mutex> lock(stateMutex_);
-    for (const auto &[_, ep] : keyToEndpoint_) {
-      endpoints.push_back(ep);
+    for (const auto &[_, pid] : endpointToPlayerId_) {
+      rtype::net::PlayerEntry pe{};
+      pe.id = pid;
+      std::uint8_t lives = 0;
+      if (auto *l = reg.get<rt::game::Lives>(pid))
+        lives = l->value;
+      pe.lives = std::min<std::uint8_t>(lives, 10);
+      if (auto *n = reg.get<rt::game::Name>(pid))
+        std::strncpy(pe.name, n->value.c_str(), sizeof(pe.name) - 1);
+      else
+        std::snprintf(pe.name, sizeof(pe.name), "Player%u", pid);
+      if (auto *st = reg.get<rt::game::ShipType>(pid))
+        pe.shipId = st->value;
+      snap->roster.push_back(pe);
     }
+    snap->hostId = hostId_;
+    snap->started = gameStarted_;
+    snap->teamScore = lastTeamScore_;
   }
-  for (const auto &ep : endpoints) {
-    send_(ep, out.data(), out.size());
-  }
+  snapshots_.publish();
 }
 
-void GameSession::broadcastState() {
+GameSession::Snapshots::Reader GameSession::latestSnapshot() {
+  return snapshots_.read();
+}
+
+void GameSession::broadcastState(const WorldSnapshot &snap) {
   rtype::net::Header hdr{};
   hdr.version = rtype::net::ProtocolVersion;
   hdr.type = rtype::net::MsgType::State;
@@ -653,174 +772,60 @@ void GameSession::broadcastState() {
           ? ((kMaxUdpBytes - (kHeaderBytes + kStateHdrBytes)) / kEntBytes)
           : 0;
 
-  std::vector<rtype::net::PackedEntity> players;
-  std::vector<rtype::net::PackedEntity> bullets;
-  std::vector<rtype::net::PackedEntity> enemies;
-  std::vector<rtype::net::PackedEntity> powerups;
-  players.reserve(16);
-  bullets.reserve(64);
-  enemies.reserve(64);
-  powerups.reserve(16);
-
-  reg_.withLock([&](auto &reg) {
-    auto &types = reg.template storage<rt::game::NetType>().data();
-    for (auto &[e, nt] : types) {
-      auto *tr = reg.template get<rt::game::Transform>(e);
-      auto *ve = reg.template get<rt::game::Velocity>(e);
-      auto *co = reg.template get<rt::game::ColorRGBA>(e);
-      if (!tr || !ve || !co)
-        continue;
-      rtype::net::PackedEntity pe{};
-      pe.id = e;
-      pe.type = nt.type;
-      pe.x = tr->x;
-      pe.y = tr->y;
-      pe.vx = ve->vx;
-      pe.vy = ve->vy;
-      pe.rgba = co->rgba;
-      switch (nt.type) {
-      case rtype::net::EntityType::Player:
-        players.push_back(pe);
-        break;
-      case rtype::net::EntityType::Bullet:
-        bullets.push_back(pe);
-        break;
-      case rtype::net::EntityType::Powerup:
-        powerups.push_back(pe);
-        break;
-      case rtype::net::EntityType::Enemy:
-      default:
-        enemies.push_back(pe);
-        break;
-      }
-    }
-  });
-
-  // Copy endpoints under lock for broadcasting
-  std::vector<asio::ip::udp::endpoint> endpoints;
-  {
-    std::lock_guard<std::mutex> lock(stateMutex_);
-    for (const auto &[key, ep] : keyToEndpoint_) {
-      endpoints.push_back(ep);
-    }
-  }
+  std::pmr::memory_resource *mem = scratch();
+  using Entities = std::vector<rtype::net::PackedEntity>;
+  const auto eps = boundEndpoints(mem);
 
-  // Split across two datagrams to avoid crowding out enemies when bullets
-  // spike.
-  auto sendBatch = [&](const std::vector<rtype::net::PackedEntity> &batch) {
+  // Two datagrams, each filled from its kinds in order up to maxEntities, so
+  // a bullet spike cannot crowd out enemies
+  std::pmr::vector<char> out(mem);
+  auto sendBatch = [&](const Entities &first, const Entities &second) {
+    const std::size_t n1 = std::min(first.size(), maxEntities);
+    const std::size_t n2 = std::min(second.size(), maxEntities - n1);
     rtype::net::StateHeader sh{};
-    sh.count = static_cast<std::uint16_t>(batch.size());
-    std::size_t payloadSize = sizeof(rtype::net::StateHeader) +
-                              batch.size() * sizeof(rtype::net::PackedEntity);
+    sh.count = static_cast<std::uint16_t>(n1 + n2);
+    std::size_t payloadSize =
+        sizeof(rtype::net::StateHeader) + (n1 + n2) * kEntBytes;
     hdr.size = static_cast<std::uint16_t>(payloadSize);
-    std::vector<char> out(sizeof(rtype::net::Header) + payloadSize);
-    std::memcpy(out.data(), &hdr, sizeof(hdr));
-    std::memcpy(out.data() + sizeof(hdr), &sh, sizeof(sh));
-    auto *arr = reinterpret_cast<rtype::net::PackedEntity *>(
-        out.data() + sizeof(hdr) + sizeof(sh));
-    for (std::uint16_t i = 0; i < sh.count; ++i)
-      arr[i] = batch[i];
-    for (const auto &ep : endpoints)
+    out.resize(sizeof(rtype::net::Header) + payloadSize);
+    char *at = out.data();
+    std::memcpy(at, &hdr, sizeof(hdr));
+    std::memcpy(at += sizeof(hdr), &sh, sizeof(sh));
+    at += sizeof(sh);
+    if (n1)
+      std::memcpy(at, first.data(), n1 * kEntBytes);
+    if (n2)
+      std::memcpy(at + n1 * kEntBytes, second.data(), n2 * kEntBytes);
+    for (const auto &ep : eps)
       send_(ep, out.data(), out.size());
   };
 
   // Packet A: players + enemies (authoritative for presence)
-  std::vector<rtype::net::PackedEntity> a;
-  a.reserve(
-      std::min<std::size_t>(players.size() + enemies.size(), maxEntities));
-  auto appendLimitedA = [&](const std::vector<rtype::net::PackedEntity> &src) {
-    for (const auto &pe : src) {
-      if (a.size() >= maxEntities)
-        break;
-      a.push_back(pe);
-    }
-  };
-  appendLimitedA(players);
-  appendLimitedA(enemies);
-  sendBatch(a);
-
+  sendBatch(snap.players, snap.enemies);
   // Packet B: bullets + powerups (may be many; send as much as fits)
-  std::vector<rtype::net::PackedEntity> b;
-  b.reserve(
-      std::min<std::size_t>(bullets.size() + powerups.size(), maxEntities));
-  auto appendLimitedB = [&](const std::vector<rtype::net::PackedEntity> &src) {
-    for (const auto &pe : src) {
-      if (b.size() >= maxEntities)
-        break;
-      b.push_back(pe);
-    }
-  };
-  appendLimitedB(bullets);
-  appendLimitedB(powerups);
-  if (!b.empty())
-    sendBatch(b);
+  if (!snap.bullets.empty() || !snap.powerups.empty())
+    sendBatch(snap.bullets, snap.powerups);
 }
 
-void GameSession::broadcastRoster() {
+void GameSession::broadcastRoster(const WorldSnapshot &snap) {
   rtype::net::RosterHeader rh{};
-  std::vector<rtype::net::PlayerEntry> entries;
-  std::vector<asio::ip::udp::endpoint> endpoints;
-
-  std::vector<std::pair<std::uint32_t, std::string>> playerIdsAndNames;
-
-  {
-    std::lock_guard<std::mutex> lock(stateMutex_);
-    for (const auto &[key, pid] : endpointToPlayerId_) {
-      // We can't access registry here to get Name/Lives!
-      // So we just collect IDs.
-      playerIdsAndNames.push_back({pid, key});
-    }
-
-    for (const auto &[_, ep] : keyToEndpoint_) {
-      endpoints.push_back(ep);
-    }
-  }
-
-  // Now access registry to get details
-  reg_.withLock([&](auto &reg) {
-    entries.reserve(playerIdsAndNames.size());
-    for (const auto &[pid, key] : playerIdsAndNames) {
-      rtype::net::PlayerEntry pe{};
-      pe.id = pid;
-
-      std::uint8_t lives = 0;
-      if (auto *l = reg.template get<rt::game::Lives>(pid))
-        lives = l->value;
-      if (lives > 10)
-        lives = 10;
-      pe.lives = lives;
-
-      std::string name = "Player" + std::to_string(pid);
-      if (auto *n = reg.template get<rt::game::Name>(pid))
-        name = n->value;
-      std::memset(pe.name, 0, sizeof(pe.name));
-      std::strncpy(pe.name, name.c_str(), sizeof(pe.name) - 1);
-
-      std::uint8_t shipId = 0;
-      if (auto *s = reg.template get<rt::game::ShipType>(pid))
-        shipId = s->value;
-      pe.shipId = shipId;
-
-      entries.push_back(pe);
-    }
-  });
-
-  rh.count = static_cast<std::uint8_t>(entries.size());
+  rh.count = static_cast<std::uint8_t>(snap.roster.size());
 
   rtype::net::Header hdr{};
   hdr.version = rtype::net::ProtocolVersion;
   hdr.type = rtype::net::MsgType::Roster;
   hdr.size = static_cast<std::uint16_t>(
-      sizeof(rh) + entries.size() * sizeof(rtype::net::PlayerEntry));
+      sizeof(rh) + snap.roster.size() * sizeof(rtype::net::PlayerEntry));
 
-  std::vector<char> out(sizeof(hdr) + hdr.size);
+  std::pmr::memory_resource *mem = scratch();
+  std::pmr::vector<char> out(sizeof(hdr) + hdr.size, mem);
   std::memcpy(out.data(), &hdr, sizeof(hdr));
   std::memcpy(out.data() + sizeof(hdr), &rh, sizeof(rh));
-  if (!entries.empty())
-    std::memcpy(out.data() + sizeof(hdr) + sizeof(rh), entries.data(),
-                entries.size() * sizeof(rtype::net::PlayerEntry));
+  if (!snap.roster.empty())
+    std::memcpy(out.data() + sizeof(hdr) + sizeof(rh), snap.roster.data(),
+                snap.roster.size() * sizeof(rtype::net::PlayerEntry));
 
-  for (const auto &ep : endpoints)
+  for (const auto &ep : boundEndpoints(mem))
     send_(ep, out.data(), out.size());
 }
 
@@ -830,18 +835,11 @@ void GameSession::broadcastLivesUpdate(std::uint32_t id, std::uint8_t lives) {
   hdr.type = rtype::net::MsgType::LivesUpdate;
   hdr.size = sizeof(rtype::net::LivesUpdatePayload);
   rtype::net::LivesUpdatePayload p{id, lives};
-  std::vector<char> out(sizeof(hdr) + sizeof(p));
+  std::array<char, sizeof(hdr) + sizeof(p)> out;
   std::memcpy(out.data(), &hdr, sizeof(hdr));
   std::memcpy(out.data() + sizeof(hdr), &p, sizeof(p));
 
-  std::vector<asio::ip::udp::endpoint> endpoints;
-  {
-    std::lock_guard<std::mutex> lock(stateMutex_);
-    for (const auto &[_, ep] : keyToEndpoint_) {
-      endpoints.push_back(ep);
-    }
-  }
-  for (const auto &ep : endpoints)
+  for (const auto &ep : boundEndpoints(scratch()))
     send_(ep, out.data(), out.size());
 }
 
@@ -852,7 +850,7 @@ void GameSession::broadcastLobbyStatus() {
   hdr.size = sizeof(rtype::net::LobbyStatusPayload);
 
   rtype::net::LobbyStatusPayload payload{};
-  std::vector<asio::ip::udp::endpoint> endpoints;
+  std::pmr::vector<asio::ip::udp::endpoint> endpoints(scratch());
 
   {
     std::lock_guard<std::mutex> lock(stateMutex_);
@@ -867,7 +865,7 @@ void GameSession::broadcastLobbyStatus() {
     }
   }
 
-  std::vector<char> out(sizeof(hdr) + sizeof(payload));
+  std::array<char, sizeof(hdr) + sizeof(payload)> out;
   std::memcpy(out.data(), &hdr, sizeof(hdr));
   std::memcpy(out.data() + sizeof(hdr), &payload, sizeof(payload));
 
@@ -880,6 +878,157 @@ void GameSession::maybeStartGame() {
   // message Kept for backwards compatibility but does nothing
 }
 
+void GameSession::applyInputs(rt::ecs::Registry &reg) {
+  const auto now = std::chrono::steady_clock::now();
+  inputsApplied_ += inputs_.drain([&](const InputRecord &in) {
+    inputWaitMax_ = std::max(inputWaitMax_, now - in.recvTime);
+    // Stale ids (player left since) are rejected by the generation check
+    if (auto *pi = reg.get<rt::game::PlayerInput>(in.playerId))
+      pi->bits = in.bits;
+  });
+}
+
+void GameSession::handleEvents(rt::ecs::Registry &reg) {
+  bool scoreChanged = false;
+  reg.ctx<rt::game::GameEvents>().drain([&](const rt::game::GameEvent &ev) {
+    std::visit(
+        rt::game::Handlers{
+            [&](const rt::game::PlayerHit &hit) { onPlayerHit(reg, hit.player); },
+            [&](const rt::game::PowerupTaken &pt) {
+              if (pt.type == rt::game::PowerupType::Life)
+                onExtraLife(reg, pt.player);
+            },
+            [&](const rt::game::EnemyKilled &k) {
+              kills_.push_back({k.enemy, k.killer, k.points, 0});
+              scoreChanged |= k.points != 0;
+            },
+            [&](const rt::game::BossDefeated &k) {
+              kills_.push_back({k.boss, k.killer, k.points, 1});
+              scoreChanged |= k.points != 0;
+            },
+            [&](const rt::game::EntityDespawned &d) {
+              // A player leaving also takes their score off the team total
+              if (d.type == rtype::net::EntityType::Player)
+                scoreChanged = true;
+              despawned_.push_back(d.entity);
+            },
+        },
+        ev);
+  });
+  if (!kills_.empty()) {
+    broadcastKills(kills_);
+    kills_.clear();
+  }
+  if (scoreChanged)
+    updateTeamScore(reg);
+}
+
+void GameSession::onPlayerHit(rt::ecs::Registry &reg, rt::ecs::Entity e) {
+  if (!reg.has<rt::game::PlayerInput>(e))
+    return;
+  std::uint8_t lives = 0;
+  if (auto *l = reg.get<rt::game::Lives>(e)) {
+    if (l->value > 0) {
+      l->value--;
+      lives = l->value;
+    }
+  }
+  broadcastLivesUpdate(e, lives);
+  if (auto *t = reg.get<rt::game::Transform>(e)) {
+    constexpr float kStartX = 50.f;
+    constexpr float kWorldH = 600.f;
+    constexpr float kTopMargin = 56.f;
+    constexpr float kBottomMargin = 10.f;
+    float y = t->y;
+    float maxY = kWorldH - kBottomMargin - 12.f;
+    if (y < kTopMargin)
+      y = kTopMargin;
+    if (y > maxY)
+      y = maxY;
+    t->x = kStartX;
+    t->y = y;
+  }
+  if (auto *v = reg.get<rt::game::Velocity>(e)) {
+    v->vx = 0.f;
+    v->vy = 0.f;
+  }
+  rt::game::grantInvincible(reg, e, 1.0f);
+}
+
+void GameSession::onExtraLife(rt::ecs::Registry &reg, rt::ecs::Entity e) {
+  if (!reg.has<rt::game::PlayerInput>(e))
+    return;
+  std::uint8_t lives = 0;
+  if (auto *l = reg.get<rt::game::Lives>(e)) {
+    lives = l->value;
+    if (lives < 10) {
+      lives++;
+      l->value = lives;
+    }
+  }
+  broadcastLivesUpdate(e, lives);
+}
+
+// Team total over the connected players; only called when a kill scored or
+// a player left
+void GameSession::updateTeamScore(rt::ecs::Registry &reg) {
+  std::int32_t teamScore = 0;
+  for (auto &[e, inp] : reg.storage<rt::game::PlayerInput>().data()) {
+    (void)inp;
+    if (auto *sc = reg.get<rt::game::Score>(e))
+      teamScore += sc->value;
+  }
+
+  std::pmr::vector<asio::ip::udp::endpoint> endpoints(scratch());
+  {
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    if (teamScore == lastTeamScore_)
+      return;
+    lastTeamScore_ = teamScore;
+    for (const auto &[_, ep] : keyToEndpoint_) {
+      endpoints.push_back(ep);
+    }
+  }
+
+  rtype::net::Header hdr{};
+  hdr.version = rtype::net::ProtocolVersion;
+  hdr.type = rtype::net::MsgType::ScoreUpdate;
+  hdr.size = sizeof(rtype::net::ScoreUpdatePayload);
+  rtype::net::ScoreUpdatePayload p{0, teamScore};
+  std::array<char, sizeof(hdr) + sizeof(p)> out;
+  std::memcpy(out.data(), &hdr, sizeof(hdr));
+  std::memcpy(out.data() + sizeof(hdr), &p, sizeof(p));
+  for (const auto &ep : endpoints) {
+    send_(ep, out.data(), out.size());
+  }
+}
+
+void GameSession::broadcastKills(
+    const std::vector<rtype::net::KillEntry> &kills) {
+  std::pmr::memory_resource *mem = scratch();
+  const auto eps = boundEndpoints(mem);
+
+  // At most 255 entries per message
+  constexpr std::size_t kMaxPerMessage = 255;
+  for (std::size_t first = 0; first < kills.size(); first += kMaxPerMessage) {
+    const std::size_t count = std::min(kMaxPerMessage, kills.size() - first);
+    rtype::net::Header hdr{};
+    hdr.version = rtype::net::ProtocolVersion;
+    hdr.type = rtype::net::MsgType::Kill;
+    hdr.size = static_cast<std::uint16_t>(
+        sizeof(rtype::net::KillHeader) + count * sizeof(rtype::net::KillEntry));
+    rtype::net::KillHeader kh{static_cast<std::uint8_t>(count)};
+    std::pmr::vector<char> out(sizeof(hdr) + hdr.size, mem);
+    std::memcpy(out.data(), &hdr, sizeof(hdr));
+    std::memcpy(out.data() + sizeof(hdr), &kh, sizeof(kh));
+    std::memcpy(out.data() + sizeof(hdr) + sizeof(kh), kills.data() + first,
+                count * sizeof(rtype::net::KillEntry));
+    for (const auto &ep : eps) {
+      send_(ep, out.data(), out.size());
+    }
+  }
+}
+
 void GameSession::cleanupGameWorld(rt::ecs::Registry &reg) {
   // Clean up all non-player entities (enemies, bullets, powerups,
   // formations)
@@ -916,3 +1065,13 @@ void GameSession::cleanupGameWorld(rt::ecs::Registry &reg) {
 std::string GameSession::makeKey(const asio::ip::udp::endpoint &ep) {
   return makeKeyLocal(ep);
 }
+
+std::pmr::vector<asio::ip::udp::endpoint>
+GameSession::boundEndpoints(std::pmr::memory_resource *mem) const {
+  std::pmr::vector<asio::ip::udp::endpoint> out(mem);
+  std::lock_guard<std::mutex> lock(stateMutex_);
+  out.reserve(keyToEndpoint_.size());
+  for (const auto &[_, ep] : keyToEndpoint_)
+    out.push_back(ep);
+  return out;
+}